@@ -3,23 +3,49 @@
 #include "snake.hpp"
 
 #include <iostream>
-#include <thread>
 #include <chrono>
 #include <vector>
 
-/// @brief Private constructor to enforce the Singleton pattern.
+/// @brief Constructs a simulation in the START state.
 SnazeSimulation::SnazeSimulation() : current_state(states::START) { }
 
+/// @brief Restarts the random choices of the run from a seed.
+void SnazeSimulation::reseed(std::uint32_t new_seed){
+    seed = new_seed;
+    rng.seed(seed);
+    snake_obj.seed(rng()); // Drawn once, so the food does not depend on what the AI draws
+    for (Level& level : levels) level.reset_food(rng);
+}
+
+/// @brief Writes the recorded moves to the `--record` file, if any.
+void SnazeSimulation::save_recording() const {
+    if (record_path.empty()) return;
+    if (not replay_log.save(record_path)) {
+        std::cerr << "Error: could not write the replay log to " << record_path << ".\n";
+    }
+}
+
 /// @brief Processes events based on the current game state.
 void SnazeSimulation::process_events(){
-    std::this_thread::sleep_for(std::chrono::milliseconds(1000/fps));
-    
     switch (current_state) {
         case states::START_SCREEN:
             input_process();
             break;
         case states::SNAKE_THINKING:
-            snake_thinking();
+            // Only frames are paced; prompts and pauses wait for the player instead.
+            if (not headless) {
+                frame_clock.wait();
+                process_hotkeys(std::chrono::milliseconds::zero());
+            }
+            if (current_state == states::SNAKE_THINKING) {
+                if (replaying) replay_thinking();
+                else snake_thinking();
+            }
+            break;
+        case states::PAUSED:
+            process_hotkeys(std::chrono::milliseconds(50));
+            // Resumed or stepping: this iteration is a frame, and `update()` will move the snake.
+            if (current_state == states::SNAKE_THINKING) snake_thinking();
             break;
         case states::GAME_RUNNING:
             input_colision(snake_obj.found_foods, snake_obj.collision);
@@ -59,18 +85,39 @@ void SnazeSimulation::update(){
 
 /// @brief Renders the game elements to the screen.
 void SnazeSimulation::render(){
+    // Headless runs skip every screen; the caller reports the summary once the game is over.
+    if (headless) {
+        switch (current_state) {
+            case states::GAME_RUNNING:
+                current_state = states::SNAKE_THINKING;
+                break;
+            default:
+                break;
+        }
+        return;
+    }
+
     switch (current_state) {
         case states::WELCOME:
             print_welcome();
             break;
         case states::GAME_RUNNING:
-            print_maze();
-            break;
+            // Late frames are simulated without being drawn, until the loop is on time again.
+            if (frame_clock.behind()) {
+                frame_clock.skip_render();
+                current_state = states::SNAKE_THINKING;
+            } else {
+                print_maze();
+            }
+            break;
+        // Prompts are drawn once, then wait for <ENTER> over several loop iterations.
         case states::SNAKE_CRASHED:
-            print_snake_crashed();
+            if (not prompt_drawn) print_snake_crashed();
+            prompt_drawn = true;
             break;
         case states::LEVEL_UP:
-            print_level_up();
+            if (not prompt_drawn) print_level_up();
+            prompt_drawn = true;
             break;
         case states::GAME_WON:
             print_game_won();
@@ -84,4 +131,6 @@ void SnazeSimulation::render(){
 }
 
 /// @brief Checks if the game simulation is over.
-bool SnazeSimulation::is_over(){ return current_state == states::GAME_OVER; }
\ No newline at end of file
+bool SnazeSimulation::is_over(){
+    return current_state == states::GAME_OVER or current_state == states::GAME_WON;
+}
\ No newline at end of file
@@ -1,10 +1,28 @@
 #ifndef SIMULATION_HPP
 #define SIMULATION_HPP  
 
+#include "async_presenter.hpp"
+#include "frame_clock.hpp"
+#include "frame_composer.hpp"
+#include "hamiltonian.hpp"
+#include "keyboard_input.hpp"
 #include "level.hpp"
+#include "replay_log.hpp"
+#include "thread_pool.hpp"
 #include "snake.hpp"
+#include "terminal_renderer.hpp"
 #include "tile_pos.hpp"
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
 /// @brief Enumerates the possible states of the Snaze game simulation.
 enum class states {
     START = 0,      ///< Initial state of the simulation.
@@ -12,6 +30,7 @@ enum class states {
     START_SCREEN,   ///< Displays the start game screen, waiting for user input.
     SNAKE_THINKING, ///< The snake AI is calculating its next move.
     GAME_RUNNING,   ///< The game is actively running.
+    PAUSED,         ///< The player paused the game; it may step one frame at a time.
     SNAKE_CRASHED,  ///< The snake has crashed into a wall or itself.
     LEVEL_UP,       ///< The current level has been completed.
     GAME_WON,       ///< All levels have been completed, and the game is won.
@@ -21,31 +40,105 @@ enum class states {
 /// @brief Enumerates the types of AI players available for the snake.
 enum class player_type_e {
     RANDOM = 0,
-    BACKTRACKING
+    BACKTRACKING,  ///< Depth-first branch and bound over snake states.
+    ASTAR,         ///< A* search with Manhattan heuristic.
+    BIDIRECTIONAL, ///< Breadth-first search from the head and from the food at once.
+    FIELD,         ///< Descends a distance field computed once per food.
+    SURVIVAL,      ///< Shortest path to the food, unless it would cut the snake off from its tail.
+    HAMILTONIAN,   ///< Follows a precomputed Hamiltonian cycle, taking shortcuts while the snake is short.
+    BFS,           ///< Breadth-first search on the grid as it is now.
+    ANYTIME,       ///< Refines its move until the frame's time budget runs out.
+    MONTE_CARLO,   ///< Scores every legal move with random rollouts played in parallel.
+    BITBOARD       ///< Breadth-first search expanding whole frontiers with bitset operations.
+};
+
+/**
+ * @brief Gets the command-line name of a player type.
+ *
+ * @param type The player type.
+ * @return Its name, as given to `--playertype`.
+ */
+std::string_view player_name(player_type_e type);
+
+/**
+ * @brief Reads a player type from its command-line name.
+ *
+ * @param name The name, as given to `--playertype`.
+ * @param type Receives the player type.
+ * @return False if `name` is not the name of a player type.
+ */
+bool parse_player_type(std::string_view name, player_type_e& type);
+
+/// @brief Work done by the snake AI, as reported by the headless summary.
+struct ThinkStats {
+    std::size_t decisions = 0;     ///< Number of moves the AI decided on.
+    std::size_t plans = 0;         ///< Number of those that needed a new search (not taken from the cached path).
+    std::size_t nodes = 0;         ///< Number of tiles expanded by those searches.
+    std::size_t pruned = 0;        ///< Number of moves cut by the backtracking search's lower bound.
+    std::size_t cache_probes = 0;  ///< Number of transposition table lookups of the backtracking search.
+    std::size_t cache_hits = 0;    ///< Number of those lookups that cut a branch.
+    double think_ms = 0.0;         ///< Time spent deciding, in milliseconds.
+    double budget_ms = 0.0;        ///< Time the frames gave to deciding, in milliseconds.
+    std::size_t overruns = 0;      ///< Number of decisions that took longer than their frame.
+
+    /// @brief Adds the counters of another `ThinkStats` to these.
+    ThinkStats& operator+=(const ThinkStats& other) {
+        decisions += other.decisions;
+        plans += other.plans;
+        nodes += other.nodes;
+        pruned += other.pruned;
+        cache_probes += other.cache_probes;
+        cache_hits += other.cache_hits;
+        think_ms += other.think_ms;
+        budget_ms += other.budget_ms;
+        overruns += other.overruns;
+        return *this;
+    }
+};
+
+/// @brief Outcome of a finished simulation, as reported by the headless summary.
+struct RunSummary {
+    bool won = false;              ///< Whether every level was cleared.
+    bool capped = false;           ///< Whether the run was stopped at the step limit before the game was over.
+    int score = 0;                 ///< Final score.
+    int lives = 0;                 ///< Lives left at the end of the run.
+    std::size_t steps = 0;         ///< Number of moves the snake made.
+    int levels_cleared = 0;        ///< Number of levels completed.
+    int food = 0;                  ///< Number of food pellets eaten over all levels.
+    int deaths = 0;                ///< Number of lives lost.
+    double wall_ms = 0.0;          ///< Wall-clock duration of the run, in milliseconds.
+    std::uint32_t seed = 0;        ///< Seed the run was played with.
+    ThinkStats thinking;           ///< Work done by the snake AI over all levels.
+};
+
+/// @brief Levels loaded from one input file, as a range of the simulation's levels.
+struct LevelFile {
+    std::string path;              ///< The file, as given on the command line.
+    std::size_t first = 0;         ///< Index of its first level.
+    std::size_t count = 0;         ///< Number of levels it holds.
 };
 
+/**
+ * @brief Writes a run summary as space-separated `key=value` pairs.
+ *
+ * @param os The output stream.
+ * @param result The summary to write.
+ * @return The output stream.
+ */
+std::ostream& operator<<(std::ostream& os, const RunSummary& result);
+
 /**
  * @brief The main simulation class for the Snaze game.
  *
- * This class implements the Singleton design pattern to ensure only one instance
- * of the game simulation exists. It manages the game states, levels, snake behavior,
- * score, lives, and overall game flow.
+ * Each instance is an independent game: it manages the game states, levels, snake
+ * behavior, score, lives, and overall game flow. Instances share no state, so several
+ * of them may run in parallel (see `run_batch()`).
  */
 class SnazeSimulation{
 private:
-    /**
-     * @brief Private constructor to enforce the Singleton pattern.
-     *
-     * @details Initializes the current_state to START.
-     */
-    SnazeSimulation();
-
-    // Prevent copying and assignment to ensure a single instance.
-    SnazeSimulation(const SnazeSimulation&) = delete;             ///< Deleted copy constructor.
-    SnazeSimulation& operator=(const SnazeSimulation&) = delete;  ///< Deleted assignment operator.
-
     states current_state;          ///< The current state of the game simulation.
     std::vector<Level> levels;     ///< Collection of game levels.
+    std::vector<LevelFile> level_files; ///< Levels of each input file, in command-line order.
     Snake snake_obj;               ///< The snake object controlled by the simulation.
     TilePos head_pos;              ///< The current position of the snake's head.
     direction dir;                 ///< The current direction of the snake.
@@ -58,18 +151,55 @@ private:
     int n_lives = 5;     ///< Total number of lives for the player. Defaults to 5.
     int n_food = 10;     ///< Total amount of food to be collected per level. Defaults to 10.
     player_type_e player_type = player_type_e::BACKTRACKING;  ///< The type of AI controlling the snake. Defaults to BACKTRACKING.
+    bool headless = false;  ///< Runs without frame sleep, rendering or keyboard input. Defaults to false.
+    bool async_render = false; ///< Draws the running game on a render thread. Defaults to false.
+    int n_jobs = 1;         ///< Number of independent games played by the batch runner. Defaults to 1.
+    bool bench = false;     ///< Runs the microbenchmarks instead of a game. Defaults to false.
+    std::size_t node_budget = 20000; ///< Moves the backtracking player may try per search. Defaults to 20000.
+    std::size_t n_rollouts = 64;     ///< Rollouts per legal move of the Monte Carlo player. Defaults to 64.
+    std::size_t n_threads = 0;       ///< Threads playing the rollouts; 0 means one per hardware thread.
+    std::vector<player_type_e> tournament_players; ///< Player types compared by `--tournament`; empty otherwise.
+    int n_seeds = 5;                 ///< Seeds every tournament pairing is played with. Defaults to 5.
+    std::size_t max_steps = 50000;   ///< Moves after which a headless run is stopped. Defaults to 50000.
+    bool json_output = false;        ///< Writes the tournament tables as JSON instead of CSV. Defaults to false.
 
     int current_level_index = 0;   ///< The index of the current active level.
     int current_life = n_lives;    ///< The current number of remaining lives.
     int current_food = 0;          ///< The amount of food collected in the current level.
 
+    // Run statistics reported by the headless summary
+    std::size_t n_steps = 0;       ///< Number of moves the snake has made so far.
+    int levels_cleared = 0;        ///< Number of levels completed so far.
+    int food_eaten = 0;            ///< Number of food pellets eaten over all levels so far.
+    std::chrono::steady_clock::time_point start_time; ///< Moment the simulation finished initializing.
+    std::vector<ThinkStats> level_stats; ///< Work done by the snake AI, per level.
+    std::shared_ptr<WorkStealingPool> rollout_pool; ///< Threads of the Monte Carlo player, shared by the copies of the simulation.
+    std::vector<HamiltonianCycle> cycles; ///< Hamiltonian cycle of every level, for the HAMILTONIAN player; empty if none was found.
+    TerminalRenderer renderer;     ///< Draws the running game, redrawing only the tiles that changed.
+    FrameComposer screen;          ///< Buffer the screens are composed in; reused from one screen to the next.
+    std::shared_ptr<AsyncPresenter> presenter; ///< Render thread, with `--async-render`; null otherwise.
+    FrameClock frame_clock;        ///< Paces the frames of interactive runs on `fps`.
+    KeyboardInput keyboard;        ///< Keys pressed by the player, read without blocking.
+    bool step_once = false;        ///< The player asked for one frame while paused.
+    bool prompt_drawn = false;     ///< The crash or level-up prompt is on screen, waiting for <ENTER>.
+
+    // Randomness, recording and replay
+    std::mt19937 rng;              ///< The generator every random choice of the run comes from.
+    std::uint32_t seed = 0;        ///< Seed of `rng`.
+    bool seeded = false;           ///< Whether the seed was given with `--seed`.
+    std::uint64_t level_hash = fnv1a(""); ///< Hash of the lines of the level files, in order.
+    std::string record_path;       ///< File the moves are written to, with `--record`; empty otherwise.
+    bool replaying = false;        ///< Whether the moves come from `replay_log` instead of the AI (`--replay`).
+    bool replay_diverged = false;  ///< The replay ran out of moves before the game ended.
+    ReplayLog replay_log;          ///< Moves being recorded, or being replayed.
+
 public:
     /**
-     * @brief Gets the single instance of the SnazeSimulation class.
+     * @brief Constructs a simulation in the START state.
      *
-     * @return A reference to the single SnazeSimulation instance.
+     * The simulation is not playable until `initialize()` loads its levels.
      */
-    static SnazeSimulation& getInstance();
+    SnazeSimulation();
 
     /**
      * @brief Initializes the simulation based on command line arguments.
@@ -82,12 +212,90 @@ public:
     /**
      * @brief Checks if the game simulation is over.
      *
-     * @details The game is considered over when the current state is GAME_OVER.
+     * @details The game is considered over when the current state is GAME_OVER or GAME_WON.
      *
      * @return True if the game is over, false otherwise.
      */
     bool is_over();
 
+    /**
+     * @brief Checks if a headless run has made `--max-steps` moves.
+     *
+     * Headless loops stop there, so that a level whose food the snake cannot reach
+     * does not keep them running forever. Interactive games and replays (which end
+     * with their log) have no limit.
+     *
+     * @return True if the run is headless and reached the step limit.
+     */
+    bool step_limit_reached() const { return headless and not replaying and n_steps >= max_steps; }
+
+    /**
+     * @brief Gets the number of games requested with `--jobs`.
+     *
+     * @return The number of independent games to play. 1 means a single regular game.
+     */
+    int jobs() const { return n_jobs; }
+
+    /**
+     * @brief Plays `jobs()` independent copies of this simulation on a thread pool.
+     *
+     * Every game is a copy of this (already initialized) simulation and runs headless.
+     * One summary line is printed per game, followed by an aggregated line.
+     *
+     * @return The process exit code.
+     */
+    int run_batch() const;
+
+    /**
+     * @brief Tells whether `--tournament` was requested.
+     *
+     * @return True if player types should be compared instead of playing a game.
+     */
+    bool in_tournament() const { return not tournament_players.empty(); }
+
+    /**
+     * @brief Plays every level file against every tournament player type and seed.
+     *
+     * Each input file is a separate tournament map. The runs are headless copies of
+     * this simulation restricted to the levels of one file, played on worker threads.
+     * One table row is printed per run, followed by percentiles per file and player.
+     *
+     * @return The process exit code.
+     */
+    int run_tournament() const;
+
+    /**
+     * @brief Tells whether `--bench` was requested.
+     *
+     * @return True if the microbenchmarks should run instead of a game.
+     */
+    bool benchmarking() const { return bench; }
+
+    /**
+     * @brief Runs the microbenchmarks on every loaded level.
+     *
+     * Prints one `key=value` line per measurement.
+     *
+     * @return The process exit code.
+     */
+    int run_bench();
+
+    /**
+     * @brief Restarts the random choices of the run from a seed.
+     *
+     * Seeds the simulation's generator, draws the seed of the snake's own generator
+     * from it and places the food of every level (`Level::reset_food()`), so that the
+     * game only depends on the seed, not on the food drawn before.
+     *
+     * @param new_seed The seed.
+     */
+    void reseed(std::uint32_t new_seed);
+
+    /**
+     * @brief Writes the recorded moves to the `--record` file, if any.
+     */
+    void save_recording() const;
+
     /**
      * @brief Processes events based on the current game state.
      */
@@ -141,6 +349,16 @@ public:
      */
     void level_up();
 
+    /**
+     * @brief Searches the Hamiltonian cycle of every level, for the HAMILTONIAN player.
+     *
+     * Prints to standard error, per level, whether a cycle was found and how long the
+     * search took.
+     *
+     * @param report False to search without printing anything.
+     */
+    void precompute_cycles(bool report = true);
+
     /**
      * @brief Processes user input.
      *
@@ -148,6 +366,16 @@ public:
      */
     void input_process();
 
+    /**
+     * @brief Handles the keys pressed while the game runs or is paused.
+     *
+     * `p` or space pauses and resumes, `s` plays one frame while paused, `+` and `-`
+     * double and halve the frame rate.
+     *
+     * @param timeout How long to wait for a key if none is pending.
+     */
+    void process_hotkeys(std::chrono::milliseconds timeout);
+
     /**
      * @brief Processes the outcome of collisions.
      *
@@ -158,6 +386,28 @@ public:
      */
     void input_colision(bool food, bool colision);
 
+    /**
+     * @brief Gets the counters shown on the status line.
+     *
+     * @return Lives, score and food, current and maximum.
+     */
+    StatusLine status_line() const;
+
+    /**
+     * @brief Prepares the terminal for a screen other than the running game.
+     *
+     * Waits for the render thread (if any) to finish its frames, and makes the next
+     * frame of the running game a full redraw.
+     */
+    void claim_terminal();
+
+    /**
+     * @brief Prints how well the game loop kept its pace: achieved frame rate, jitter, missed deadlines.
+     *
+     * With `--async-render`, also stops the render thread and prints its frame counters.
+     */
+    void print_frame_stats();
+
     /**
      * @brief Prints the welcome screen to the console.
      */
@@ -165,6 +415,8 @@ public:
 
     /**
      * @brief Prints the current maze to the console.
+     *
+     * Only the first frame is drawn in full; later frames redraw the tiles that changed.
      */
     void print_maze();
 
@@ -195,6 +447,25 @@ public:
      */
     void print_game_over();
 
+    /**
+     * @brief Collects the statistics of the run so far.
+     *
+     * @return A `RunSummary` with the current score, lives, steps and timing.
+     */
+    RunSummary summary() const;
+
+    /**
+     * @brief Prints a single machine-readable line summarizing the run.
+     *
+     * Used in headless mode instead of the regular screens. The line is made of
+     * `key=value` pairs: result (won, lost or capped), score, lives, steps,
+     * levels_cleared, food, deaths, food_per_life, wall_ms and the AI's decisions,
+     * plans, nodes, nodes_per_plan,
+     * nodes_per_decision, think_ms and decisions_per_sec. It is followed by one
+     * line per level with that level's AI counters.
+     */
+    void print_summary();
+
     /**
      * @brief Respawns the snake after a crash or at the start of a level.
      */
@@ -206,6 +477,31 @@ public:
      * This method encapsulates the logic for the snake to determine its next move.
      */
     void snake_thinking();
+
+    /**
+     * @brief Takes the snake's next move from the replay log instead of thinking.
+     *
+     * Ticks where the snake had no free neighbor were not recorded: the game loses a
+     * life there whatever the player, so the replay finds them again by itself.
+     */
+    void replay_thinking();
+
+    /**
+     * @brief Runs the search of the selected player type from the snake's head.
+     *
+     * @param head The tile of the snake's head.
+     * @param next Receives the tile of the first step.
+     * @param deadline Moment the move must be decided by; anytime planners use the time up to it.
+     * @return True if a path to the food was found and `next` was set.
+     */
+    bool plan_path(cell_t head, cell_t& next, std::chrono::steady_clock::time_point deadline);
+
+    /**
+     * @brief Gets the time a frame lasts, which is the time the AI has to decide a move.
+     *
+     * @return `1 / fps` seconds.
+     */
+    std::chrono::steady_clock::duration frame_budget() const;
     
     /**
      * @brief Gets the current state of the simulation.
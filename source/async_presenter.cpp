@@ -0,0 +1,55 @@
+#include "async_presenter.hpp"
+
+#include <chrono>
+
+/// @brief How long the render thread sleeps when there is no new frame.
+static constexpr std::chrono::microseconds IDLE_WAIT{500};
+
+/// @brief Starts the render thread.
+AsyncPresenter::AsyncPresenter() : m_thread(&AsyncPresenter::run, this) { }
+
+/// @brief Body of the render thread.
+void AsyncPresenter::run() {
+    while (true) {
+        // Read the flag first: a frame published before `stop()` is still presented.
+        bool stopping = m_stop.load(std::memory_order_acquire);
+
+        if (m_frames.take()) {
+            const FrameSnapshot& frame = m_frames.front();
+            if (m_redraw.exchange(false, std::memory_order_acq_rel)) m_renderer.invalidate();
+            m_renderer.present(BoardView(frame.tiles.data(), frame.rows, frame.cols, frame.stride), frame.status);
+            m_presented.fetch_add(1, std::memory_order_release);
+        } else if (stopping) {
+            return;
+        } else {
+            std::this_thread::sleep_for(IDLE_WAIT);
+        }
+    }
+}
+
+/// @brief Copies a frame and hands it to the render thread, without waiting for it.
+void AsyncPresenter::publish(const Level& level, const StatusLine& status) {
+    FrameSnapshot& frame = m_frames.back();
+    frame.tiles.assign(level.tiles(), level.tiles() + level.tile_count());
+    frame.rows = level.n_rows();
+    frame.cols = level.n_cols();
+    frame.stride = level.stride();
+    frame.status = status;
+
+    m_simulated.fetch_add(1, std::memory_order_relaxed);
+    if (m_frames.publish()) m_dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+/// @brief Waits until every published frame was either presented or dropped.
+void AsyncPresenter::drain() const {
+    while (m_presented.load(std::memory_order_acquire) + m_dropped.load(std::memory_order_relaxed)
+           < m_simulated.load(std::memory_order_relaxed)) {
+        std::this_thread::sleep_for(IDLE_WAIT);
+    }
+}
+
+/// @brief Presents what is left and stops the render thread. Idempotent.
+void AsyncPresenter::stop() {
+    m_stop.store(true, std::memory_order_release);
+    if (m_thread.joinable()) m_thread.join();
+}
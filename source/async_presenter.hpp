@@ -0,0 +1,91 @@
+#ifndef ASYNC_PRESENTER_HPP
+#define ASYNC_PRESENTER_HPP
+
+#include "frame_composer.hpp"
+#include "level.hpp"
+#include "terminal_renderer.hpp"
+#include "triple_buffer.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+/// @brief Everything needed to draw one frame of the running game, copied out of the simulation.
+struct FrameSnapshot {
+    std::vector<std::uint8_t> tiles; ///< Copy of `Level::tiles()`.
+    size_t rows = 0;                 ///< Rows of the level.
+    size_t cols = 0;                 ///< Columns of the level.
+    size_t stride = 0;               ///< Stride of the level.
+    StatusLine status;               ///< Counters of the status line.
+};
+
+/**
+ * @brief Draws the frames of the running game on a thread of its own.
+ *
+ * The simulation publishes a snapshot per frame (`publish()`) and goes on at once; the
+ * render thread presents the newest snapshot with a `TerminalRenderer`. A snapshot
+ * published before the previous one was presented replaces it (it is dropped), so a
+ * slow terminal makes the picture skip frames instead of slowing the game down.
+ *
+ * Before printing anything else, the simulation calls `drain()` so that the two threads
+ * never write to the terminal at once, then `invalidate()` so that the next frame is
+ * drawn in full.
+ */
+class AsyncPresenter {
+private:
+    TripleBuffer<FrameSnapshot> m_frames;        ///< Hand-over of the snapshots.
+    TerminalRenderer m_renderer;                 ///< Used by the render thread only.
+    std::atomic<bool> m_redraw{false};           ///< Set by `invalidate()`, cleared by the render thread.
+    std::atomic<bool> m_stop{false};             ///< Tells the render thread to exit.
+    std::atomic<std::size_t> m_simulated{0};     ///< Snapshots published.
+    std::atomic<std::size_t> m_presented{0};     ///< Snapshots written to the terminal.
+    std::atomic<std::size_t> m_dropped{0};       ///< Snapshots replaced before being presented.
+    std::thread m_thread;                        ///< The render thread.
+
+    /// @brief Body of the render thread.
+    void run();
+
+public:
+    /// @brief Starts the render thread.
+    AsyncPresenter();
+
+    /// @brief Stops the render thread.
+    ~AsyncPresenter() { stop(); }
+
+    AsyncPresenter(const AsyncPresenter&) = delete;
+    AsyncPresenter& operator=(const AsyncPresenter&) = delete;
+
+    /**
+     * @brief Copies a frame and hands it to the render thread, without waiting for it.
+     *
+     * @param level The level to draw.
+     * @param status The counters of the status line.
+     */
+    void publish(const Level& level, const StatusLine& status);
+
+    /**
+     * @brief Waits until every published frame was either presented or dropped.
+     *
+     * Once it returns, the render thread does not touch the terminal until the next `publish()`.
+     */
+    void drain() const;
+
+    /// @brief Makes the render thread draw its next frame in full.
+    void invalidate() { m_redraw.store(true, std::memory_order_release); }
+
+    /// @brief Presents what is left and stops the render thread. Idempotent.
+    void stop();
+
+    /// @brief Gets the number of frames the simulation published.
+    std::size_t simulated() const { return m_simulated.load(); }
+
+    /// @brief Gets the number of frames written to the terminal.
+    std::size_t presented() const { return m_presented.load(); }
+
+    /// @brief Gets the number of frames replaced by a newer one before being presented.
+    std::size_t dropped() const { return m_dropped.load(); }
+};
+
+#endif
@@ -0,0 +1,85 @@
+#include "SnazeSimulation.hpp"
+#include "level.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Plays `jobs()` independent copies of this simulation on a thread pool.
+ *
+ * The pool has one worker per hardware thread (at most one per game). Workers pick
+ * the next unplayed game from a shared counter, play it to the end on their own copy
+ * of the simulation and store its `RunSummary`. Once every game is over, one line
+ * per game and an aggregated line are printed.
+ *
+ * @return EXIT_SUCCESS once every game has been played.
+ */
+int SnazeSimulation::run_batch() const {
+    std::vector<RunSummary> results(n_jobs);
+    std::atomic<int> next_game{0};
+
+    auto worker = [&]() {
+        for (int id = next_game++; id < n_jobs; id = next_game++) {
+            SnazeSimulation game = *this;
+            // With `--seed`, game `id` replays the same way on every run.
+            game.reseed(seeded ? seed + static_cast<std::uint32_t>(id) : std::random_device{}());
+            game.record_path.clear(); // Only single games are recorded
+            game.start_time = std::chrono::steady_clock::now();
+
+            while (not game.is_over() and not game.step_limit_reached()) {
+                game.process_events();
+                game.update();
+                game.render();
+            }
+
+            results[id] = game.summary();
+        }
+    };
+
+    auto batch_start = std::chrono::steady_clock::now();
+
+    int n_threads = std::max(1, std::min<int>(n_jobs, std::thread::hardware_concurrency()));
+    std::vector<std::thread> pool;
+    for (int i = 0; i < n_threads; ++i) pool.emplace_back(worker);
+    for (auto& t : pool) t.join();
+
+    std::chrono::duration<double, std::milli> batch_time = std::chrono::steady_clock::now() - batch_start;
+
+    // Aggregated results
+    int won = 0;
+    int capped = 0;
+    long long total_score = 0;
+    std::size_t total_steps = 0;
+    int min_score = results.front().score;
+    int max_score = results.front().score;
+
+    for (int id = 0; id < n_jobs; ++id) {
+        std::cout << "game=" << id << ' ' << results[id] << '\n';
+
+        won += results[id].won;
+        capped += results[id].capped;
+        total_score += results[id].score;
+        total_steps += results[id].steps;
+        min_score = std::min(min_score, results[id].score);
+        max_score = std::max(max_score, results[id].score);
+    }
+
+    std::cout << "games=" << n_jobs
+              << " threads=" << n_threads
+              << " won=" << won
+              << " capped=" << capped
+              << " mean_score=" << static_cast<double>(total_score) / n_jobs
+              << " min_score=" << min_score
+              << " max_score=" << max_score
+              << " mean_steps=" << static_cast<double>(total_steps) / n_jobs
+              << " wall_ms=" << batch_time.count() << '\n';
+
+    return EXIT_SUCCESS;
+}
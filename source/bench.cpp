@@ -0,0 +1,530 @@
+#include "SnazeSimulation.hpp"
+#include "level.hpp"
+#include "search_scratch.hpp"
+#include "snake.hpp"
+#include "terminal_renderer.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <queue>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#if defined(SNAZE_COUNT_ALLOCATIONS)
+/// @brief Number of heap allocations made by the program so far (counted by the `operator new` below).
+static std::atomic<std::size_t> n_allocations{0};
+
+/**
+ * @brief Global allocation function that counts every call.
+ *
+ * Only compiled into benchmark builds (`-DSNAZE_COUNT_ALLOCATIONS`), so that regular
+ * builds do not pay a shared counter on every allocation of every thread.
+ */
+void* operator new(std::size_t size) {
+    n_allocations.fetch_add(1, std::memory_order_relaxed);
+
+    if (void* ptr = std::malloc(size != 0 ? size : 1)) return ptr;
+
+    throw std::bad_alloc();
+}
+
+/// @brief Deallocation matching the counting `operator new`.
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+/// @brief Sized deallocation matching the counting `operator new`.
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+/// @brief Whether `allocations()` counts anything.
+static constexpr bool counts_allocations = true;
+
+/// @brief Gets the number of heap allocations made so far.
+static std::size_t allocations() { return n_allocations.load(); }
+#else
+static constexpr bool counts_allocations = false;
+static std::size_t allocations() { return 0; }
+#endif
+
+/**
+ * @brief Writes the allocations per call of a measurement, if they were counted.
+ *
+ * @param key Name of the measurement, printed as `<key>=`.
+ * @param allocs Allocations made over all the calls.
+ * @param iters Number of calls.
+ */
+static void print_allocs(const char* key, std::size_t allocs, long iters) {
+    if (counts_allocations) std::cout << ' ' << key << '=' << static_cast<double>(allocs) / iters;
+}
+
+/**
+ * @brief Measures how long a callable takes, on average, per call.
+ *
+ * The callable is repeated until at least 100ms have passed (and at least 10 times),
+ * so that fast and slow operations both get a stable average.
+ *
+ * @param fn The operation to measure.
+ * @param iters Receives the number of calls performed.
+ * @return The mean duration of a call, in microseconds.
+ */
+template <typename Fn>
+double time_per_call(Fn fn, long& iters) {
+    using clock = std::chrono::steady_clock;
+    auto start = clock::now();
+    auto elapsed = clock::duration::zero();
+
+    iters = 0;
+    while (iters < 10 or elapsed < std::chrono::milliseconds(100)) {
+        fn();
+        ++iters;
+        elapsed = clock::now() - start;
+    }
+
+    return std::chrono::duration<double, std::micro>(elapsed).count() / iters;
+}
+
+/// @brief A path search to benchmark, with the name used in the report.
+struct BenchPlanner {
+    const char* name;                                        ///< Name printed after `bench=`
+    bool (Snake::*search)(Level&, cell_t, cell_t&);          ///< The search, as a `Snake` member
+};
+
+/// @brief Every path search measured by `run_bench()`.
+const BenchPlanner planners[] = {
+    {"bfs", &Snake::breadthFirst_search},
+    {"astar", &Snake::astar_search},
+    {"bidirectional", &Snake::bidirectional_search},
+};
+
+/// @brief A kernel of the bitboard search to benchmark, with the name used in the report.
+struct BenchKernel {
+    const char* name;                 ///< Name printed after `bench=`
+    BitboardBfs::kernel_e kernel;     ///< The kernel
+};
+
+/// @brief Every bitboard kernel measured by `run_bench()` (if compiled in).
+const BenchKernel kernels[] = {
+    {"bitboard_scalar", BitboardBfs::kernel_e::SCALAR},
+    {"bitboard_sse2", BitboardBfs::kernel_e::SSE2},
+};
+
+/**
+ * @brief Places food the way `Level::place_food()` did before the free-tile index.
+ *
+ * Scans the grid for empty tiles and builds a new generator on every call. Kept as
+ * the baseline of the food placement benchmark; the level is left untouched.
+ *
+ * @param level The level to place the food in.
+ * @return The chosen position.
+ */
+TilePos scan_place_food(const Level& level) {
+    auto vec_empty_spaces = level.empty_spaces();
+
+    if (vec_empty_spaces.empty()) return TilePos();
+
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_int_distribution<> dist(0, vec_empty_spaces.size() - 1);
+
+    return vec_empty_spaces[dist(gen)];
+}
+
+/**
+ * @brief Copies a level into the nested grid `Level` stored before the flat padded grid.
+ *
+ * @param level The level.
+ * @return One vector of tile types per row.
+ */
+static std::vector<std::vector<int>> nested_grid(const Level& level) {
+    std::vector<std::vector<int>> maze(level.n_rows(), std::vector<int>(level.n_cols()));
+    for (size_t row = 0; row < level.n_rows(); ++row) {
+        for (size_t col = 0; col < level.n_cols(); ++col) {
+            maze[row][col] = level.get_tile_type(TilePos(row, col));
+        }
+    }
+    return maze;
+}
+
+/**
+ * @brief Breadth-first search the way `Snake::breadthFirst_search()` did on the nested grid.
+ *
+ * Queues `TilePos`, bounds-checks every neighbor, and allocates its visited rows and
+ * its map of parents on every call. Kept as the baseline of the path search benchmark.
+ *
+ * @param maze The level, as returned by `nested_grid()`.
+ * @param start Position of the snake's head.
+ * @param next_move Receives the first move towards the food, if found.
+ * @return The number of moves to the food; 0 if it is unreachable.
+ */
+static size_t nested_grid_bfs(const std::vector<std::vector<int>>& maze, TilePos start, TilePos& next_move) {
+    const int drow[4] = {-1, 0, 1, 0};
+    const int dcol[4] = {0, 1, 0, -1};
+    size_t n_rows = maze.size();
+    size_t n_cols = maze[0].size();
+
+    std::queue<TilePos> fila;
+    std::vector<std::vector<bool>> visit(n_rows, std::vector<bool>(n_cols, false));
+    std::unordered_map<size_t, TilePos> main; // Previous position of each visited one
+    bool found = false;
+    TilePos curr;
+
+    fila.push(start);
+    visit[start.row][start.col] = true;
+
+    while (not fila.empty()) {
+        curr = fila.front();
+        fila.pop();
+
+        if (maze[curr.row][curr.col] == Level::FOOD) {
+            found = true;
+            break;
+        }
+
+        for (int i = 0; i < 4; ++i) {
+            TilePos V(curr.row + drow[i], curr.col + dcol[i]);
+            if (V.row < n_rows and V.col < n_cols and not visit[V.row][V.col]
+                and (maze[V.row][V.col] == Level::EMPTY or maze[V.row][V.col] == Level::FOOD)) {
+                visit[V.row][V.col] = true;
+                fila.push(V);
+                main[V.row * n_cols + V.col] = curr;
+            }
+        }
+    }
+
+    if (not found) return 0;
+
+    size_t length = 1;
+    for (TilePos prev = main[curr.row * n_cols + curr.col]; not (prev == start); prev = main[prev.row * n_cols + prev.col]) {
+        curr = prev;
+        ++length;
+    }
+    next_move = curr;
+    return length;
+}
+
+/**
+ * @brief Breadth-first search the way `Snake::breadthFirst_search()` did before tile indices.
+ *
+ * Same flat grid and scratch buffers as the current search, but it takes and returns
+ * `TilePos`, builds its neighbor offsets on every call and looks the food up by
+ * position when storing the path. Kept as the baseline of the path search benchmark.
+ *
+ * @param level The level.
+ * @param start Position of the snake's head.
+ * @param next_move Receives the first move towards the food, if found.
+ * @param scratch Working memory of the search.
+ * @param path Receives the tiles of the path, from the first move to the food.
+ * @param path_food Receives the tile of the food the path leads to.
+ * @return true If the food was found.
+ */
+static bool tilepos_bfs(const Level& level, TilePos start, TilePos& next_move, SearchScratch& scratch,
+                        std::vector<std::uint32_t>& path, std::uint32_t& path_food) {
+    const std::uint8_t* tiles = level.tiles();
+    const long stride = static_cast<long>(level.stride());
+    const long offsets[4] = {-stride, 1, stride, -1}; // up, right, down, left
+
+    size_t start_idx = level.index(start);
+    size_t food_idx = start_idx;
+    bool found = false;
+    scratch.prepare(level.tile_count());
+    scratch.visit(start_idx);
+    scratch.push(start_idx);
+
+    while (not scratch.empty()) {
+        size_t curr = scratch.pop();
+
+        if (tiles[curr] == Level::FOOD) {
+            food_idx = curr;
+            found = true;
+            break;
+        }
+
+        for (long offset : offsets) {
+            size_t V = curr + offset;
+            if (not scratch.visited(V) and level.walkable(V)) {
+                scratch.visit(V);
+                scratch.pred[V] = static_cast<std::uint32_t>(curr);
+                scratch.push(V);
+            }
+        }
+    }
+
+    if (not found) return false;
+
+    path.clear();
+    for (size_t curr = food_idx; curr != start_idx; curr = scratch.pred[curr]) {
+        path.push_back(static_cast<std::uint32_t>(curr));
+    }
+    std::reverse(path.begin(), path.end());
+    path_food = level.index(level.get_food_loc());
+
+    next_move = level.position(path.front());
+    return true;
+}
+
+/**
+ * @brief Runs the microbenchmarks on every loaded level.
+ *
+ * For each level:
+ * - the snake is placed at its spawn position and every path search towards the
+ *   food is timed, counting expanded tiles and, in builds with
+ *   `-DSNAZE_COUNT_ALLOCATIONS`, the heap allocations made after a warm-up search;
+ * - the breadth-first search is also timed taking and returning `TilePos`, as it
+ *   did before tile indices (`bfs_tilepos`), and on a nested grid copy of the level,
+ *   as it was written before the flat grid (`bfs_nested_grid`), with the speedup of `bfs`;
+ * - the bitboard search is timed from the same position with each of its kernels;
+ * - a Monte Carlo decision is timed with 1 to `--threads` threads;
+ * - every search (and every bitboard kernel) is run from every free tile and must
+ *   find a path exactly as long as the breadth-first search (`path_length_check`);
+ * - frames of the running game are composed, without being written, both in full
+ *   (`full`) and as differences from the previous frame while the food moves (`diff`);
+ * - food placement is timed with the grid scan (`scan`) and with the free-tile
+ *   index (`index`), while the level is progressively filled with snake body.
+ *
+ * Then a game is played from this simulation, as a single `--seed` run would, and
+ * again from a copy reseeded the way `run_batch()` does: both must match (`seed_check`).
+ *
+ * One `key=value` line is printed per measurement.
+ *
+ * @return EXIT_SUCCESS once every level has been measured.
+ */
+int SnazeSimulation::run_bench() {
+    for (size_t id = 0; id < levels.size(); ++id) {
+        Level level = levels[id];
+        Snake snake;
+        // Same food positions on every run, so that runs can be compared
+        std::mt19937 food_rng{42};
+        snake.reset(level, food_rng);
+        level.place_food(food_rng);
+
+        cell_t start = level.spawn_cell();
+        cell_t next_move;
+        double bfs_us = 0.0;
+
+        for (const BenchPlanner& planner : planners) {
+            long iters = 0;
+
+            (snake.*planner.search)(level, start, next_move); // warm-up: sizes the scratch buffers
+            std::size_t allocs_before = allocations();
+            std::size_t nodes_before = snake.nodes_expanded;
+            double us = time_per_call([&]() { (snake.*planner.search)(level, start, next_move); }, iters);
+            std::size_t allocs = allocations() - allocs_before;
+            std::size_t nodes = snake.nodes_expanded - nodes_before;
+            if (planner.search == &Snake::breadthFirst_search) bfs_us = us;
+
+            std::cout << "bench=" << planner.name << " level=" << id
+                      << " size=" << level.n_rows() << 'x' << level.n_cols()
+                      << " iters=" << iters
+                      << " us_per_search=" << us
+                      << " nodes_per_search=" << static_cast<double>(nodes) / iters;
+            print_allocs("allocs_per_search", allocs, iters);
+            std::cout << '\n';
+        }
+
+        // Baseline: the same search with TilePos at its edges, as before tile indices
+        {
+            SearchScratch scratch;
+            std::vector<std::uint32_t> path;
+            std::uint32_t path_food;
+            TilePos first_move;
+            long iters = 0;
+
+            tilepos_bfs(level, level.position(start), first_move, scratch, path, path_food); // warm-up: sizes the buffers
+            std::size_t allocs_before = allocations();
+            double us = time_per_call([&]() { tilepos_bfs(level, level.position(start), first_move, scratch, path, path_food); }, iters);
+            std::size_t allocs = allocations() - allocs_before;
+
+            std::cout << "bench=bfs_tilepos level=" << id
+                      << " size=" << level.n_rows() << 'x' << level.n_cols()
+                      << " iters=" << iters
+                      << " us_per_search=" << us
+                      << " bfs_speedup=" << us / bfs_us
+                      << " same_path_length=" << (path.size() == snake.path_length());
+            print_allocs("allocs_per_search", allocs, iters);
+            std::cout << '\n';
+        }
+
+        // Baseline: the same search on the nested grid the level was stored in before
+        {
+            std::vector<std::vector<int>> maze = nested_grid(level);
+            TilePos first_move;
+            size_t length = 0;
+            long iters = 0;
+
+            snake.breadthFirst_search(level, start, next_move);
+            std::size_t allocs_before = allocations();
+            double us = time_per_call([&]() { length = nested_grid_bfs(maze, level.position(start), first_move); }, iters);
+            std::size_t allocs = allocations() - allocs_before;
+
+            std::cout << "bench=bfs_nested_grid level=" << id
+                      << " size=" << level.n_rows() << 'x' << level.n_cols()
+                      << " iters=" << iters
+                      << " us_per_search=" << us
+                      << " bfs_speedup=" << us / bfs_us
+                      << " same_path_length=" << (length == snake.path_length());
+            print_allocs("allocs_per_search", allocs, iters);
+            std::cout << '\n';
+        }
+
+        // Bitboard search, per kernel
+        for (const BenchKernel& kernel : kernels) {
+            if (not BitboardBfs::available(kernel.kernel)) continue;
+
+            BitboardBfs bitboard;
+            bitboard.set_kernel(kernel.kernel);
+            size_t start_idx = start;
+            size_t first_move;
+            std::size_t reached = 0;
+            long iters = 0;
+
+            double us = time_per_call([&]() { bitboard.search(level, start_idx, first_move, reached); }, iters);
+
+            std::cout << "bench=" << kernel.name << " level=" << id
+                      << " size=" << level.n_rows() << 'x' << level.n_cols()
+                      << " iters=" << iters
+                      << " us_per_search=" << us
+                      << " tiles_reached=" << reached << '\n';
+        }
+
+        // Monte Carlo player: scaling of the rollouts with the number of threads
+        size_t max_threads = n_threads ? n_threads : std::max(1u, std::thread::hardware_concurrency());
+        double single_thread_us = 0.0;
+        for (size_t threads = 1; threads <= max_threads; ++threads) {
+            WorkStealingPool pool(threads);
+            long iters = 0;
+
+            double us = time_per_call([&]() { snake.montecarlo_search(level, start, next_move, pool, n_rollouts); }, iters);
+            if (threads == 1) single_thread_us = us;
+
+            std::cout << "bench=montecarlo level=" << id
+                      << " size=" << level.n_rows() << 'x' << level.n_cols()
+                      << " threads=" << threads
+                      << " rollouts=" << n_rollouts
+                      << " iters=" << iters
+                      << " us_per_decision=" << us
+                      << " speedup=" << single_thread_us / us << '\n';
+        }
+
+        // Regression check: every search must find paths as short as the BFS, from any start
+        size_t starts = 0;
+        size_t mismatches = 0;
+        for (size_t idx = 0; idx < level.tile_count(); ++idx) {
+            if (not level.walkable(idx) or level.tiles()[idx] == Level::FOOD) continue;
+
+            cell_t from = static_cast<cell_t>(idx);
+            bool reachable = snake.breadthFirst_search(level, from, next_move);
+            size_t length = snake.path_length();
+            ++starts;
+
+            for (const BenchPlanner& planner : planners) {
+                bool found = (snake.*planner.search)(level, from, next_move);
+                if (found != reachable or (found and snake.path_length() != length)) ++mismatches;
+            }
+
+            for (const BenchKernel& kernel : kernels) {
+                if (not BitboardBfs::available(kernel.kernel)) continue;
+
+                BitboardBfs bitboard;
+                bitboard.set_kernel(kernel.kernel);
+                size_t first_move;
+                std::size_t reached;
+                if (bitboard.search(level, idx, first_move, reached) != (reachable ? length : 0)) ++mismatches;
+            }
+        }
+
+        std::cout << "bench=path_length_check level=" << id
+                  << " starts=" << starts
+                  << " mismatches=" << mismatches << '\n';
+
+        // Render throughput: composing a frame, not writing it, so the terminal does not count
+        for (bool full : {true, false}) {
+            TerminalRenderer renderer;
+            const StatusLine status{4, 5, 120, 3, 10};
+            std::size_t bytes = renderer.compose(level, status).size(); // warm-up: sizes the buffers
+            long iters = 0;
+
+            std::size_t allocs_before = allocations();
+            double us = time_per_call([&]() {
+                if (full) {
+                    renderer.invalidate();
+                } else {
+                    // Move the food, so that two tiles change per frame
+                    level.place_food(food_rng);
+                }
+                bytes = renderer.compose(level, status).size();
+            }, iters);
+            std::size_t allocs = allocations() - allocs_before;
+
+            std::cout << "bench=render level=" << id
+                      << " size=" << level.n_rows() << 'x' << level.n_cols()
+                      << " mode=" << (full ? "full" : "diff")
+                      << " iters=" << iters
+                      << " us_per_frame=" << us
+                      << " fps=" << 1e6 / us
+                      << " bytes_per_frame=" << bytes;
+            print_allocs("allocs_per_frame", allocs, iters);
+            std::cout << '\n';
+        }
+
+        // Food placement as the snake fills the board
+        std::vector<TilePos> free_tiles = level.empty_spaces();
+        std::shuffle(free_tiles.begin(), free_tiles.end(), std::mt19937{42});
+        size_t filled = 0;
+
+        for (int percent : {0, 25, 50, 75, 90, 99}) {
+            for (; filled < free_tiles.size() * percent / 100; ++filled) {
+                level.set_tile_type(Level::SNAKE_BODY, free_tiles[filled]);
+            }
+
+            long scan_iters = 0;
+            long index_iters = 0;
+            double scan_us = time_per_call([&]() { scan_place_food(level); }, scan_iters);
+            double index_us = time_per_call([&]() {
+                level.place_food(food_rng);
+                // Undo, so that the board stays the same between calls
+                level.set_tile_type(Level::EMPTY, level.get_food_loc());
+            }, index_iters);
+
+            std::cout << "bench=place_food level=" << id
+                      << " filled=" << percent << '%'
+                      << " free=" << level.n_free_tiles()
+                      << " scan_us=" << scan_us
+                      << " index_us=" << index_us << '\n';
+        }
+    }
+
+    // A batch game reseeds a copy that may already hold other food: it must still play
+    // exactly like the single run of its seed, which is this simulation as initialized.
+    RunSummary results[2];
+    for (int batch = 0; batch < 2; ++batch) {
+        SnazeSimulation game = *this;
+        game.headless = true;
+        game.player_type = player_type_e::BFS; // Any player does; this one is quick
+        if (batch) {
+            game.reseed(seed + 1);
+            game.reseed(seed);
+        }
+        game.start_time = std::chrono::steady_clock::now();
+
+        while (not game.is_over() and not game.step_limit_reached()) {
+            game.process_events();
+            game.update();
+            game.render();
+        }
+        results[batch] = game.summary();
+    }
+    bool same = results[0].won == results[1].won and results[0].score == results[1].score
+                and results[0].steps == results[1].steps and results[0].food == results[1].food
+                and results[0].deaths == results[1].deaths;
+
+    std::cout << "bench=seed_check seed=" << seed
+              << " steps=" << results[0].steps
+              << " mismatches=" << (same ? 0 : 1) << '\n';
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,230 @@
+#include "bitboard.hpp"
+#include "level.hpp"
+
+#include <algorithm>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/// @brief Creates a search that uses the fastest kernel of the build.
+BitboardBfs::BitboardBfs() : m_kernel{available(kernel_e::SSE2) ? kernel_e::SSE2 : kernel_e::SCALAR} {}
+
+/// @brief Tells whether a kernel is compiled in.
+bool BitboardBfs::available(kernel_e kernel) {
+#if defined(__SSE2__)
+    (void)kernel;
+    return true;
+#else
+    return kernel == kernel_e::SCALAR;
+#endif
+}
+
+/// @brief Sizes the bitsets (only when the level size changes) and loads the free tiles.
+void BitboardBfs::prepare(const Level& level) {
+    const size_t rows = level.n_rows();
+    const size_t cols = level.n_cols();
+
+    if (rows != m_rows or cols != m_cols) {
+        m_rows = rows;
+        m_cols = cols;
+        m_words = std::max<size_t>(2, (cols + 63) / 64);
+
+        const size_t total = (rows + 2) * m_words;
+        m_free.assign(total, 0);
+        m_visited.assign(total, 0);
+        m_frontier.assign(total, 0);
+        m_next.assign(total, 0);
+    }
+
+    const std::uint64_t* open = level.open_tiles();
+    const std::uint64_t* occupancy = level.occupancy();
+    const size_t level_words = level.occupancy_words();
+    for (size_t r = 0; r < rows; ++r) {
+        for (size_t w = 0; w < level_words; ++w) {
+            m_free[(r + 1) * m_words + w] = open[r * level_words + w] & ~occupancy[r * level_words + w];
+        }
+    }
+
+    std::fill(m_visited.begin(), m_visited.end(), 0);
+    std::fill(m_frontier.begin(), m_frontier.end(), 0);
+    std::fill(m_next.begin(), m_next.end(), 0);
+    m_frontier_lo = m_next_lo = 1;
+    m_frontier_hi = m_next_hi = 0;
+}
+
+/**
+ * @brief One BFS step on 64-bit words: `m_next` becomes the tiles next to `m_frontier`.
+ *
+ * @return True if any tile was reached.
+ */
+bool BitboardBfs::expand_scalar() {
+    const size_t words = m_words;
+    const std::uint64_t* F = m_frontier.data();
+    const std::uint64_t* free_tiles = m_free.data();
+    std::uint64_t* visited = m_visited.data();
+    std::uint64_t* N = m_next.data();
+
+    // Clear what the buffer held two steps ago.
+    for (size_t r = m_next_lo; r <= m_next_hi; ++r) {
+        std::fill(N + r * words, N + (r + 1) * words, 0);
+    }
+
+    size_t lo = m_rows + 1;
+    size_t hi = 0;
+    if (m_frontier_lo <= m_frontier_hi) {
+        size_t first = std::max<size_t>(m_frontier_lo, 2) - 1;
+        size_t last = std::min(m_frontier_hi + 1, m_rows);
+
+        for (size_t r = first; r <= last; ++r) {
+            const std::uint64_t* row = F + r * words;
+            std::uint64_t carry = 0; // bit 63 of the previous word, moving east
+            std::uint64_t any = 0;
+
+            if (words == 2) {
+                // Every level up to 128 columns: unrolled
+                size_t i = r * 2;
+                std::uint64_t grown0 = (row[0] << 1) | (row[0] >> 1) | (row[1] << 63) | F[i - 2] | F[i + 2];
+                std::uint64_t grown1 = (row[1] << 1) | (row[0] >> 63) | (row[1] >> 1) | F[i - 1] | F[i + 3];
+                std::uint64_t fresh0 = grown0 & free_tiles[i] & ~visited[i];
+                std::uint64_t fresh1 = grown1 & free_tiles[i + 1] & ~visited[i + 1];
+                visited[i] |= fresh0;
+                visited[i + 1] |= fresh1;
+                N[i] = fresh0;
+                N[i + 1] = fresh1;
+                any = fresh0 | fresh1;
+            }
+
+            for (size_t w = 0; w < words and words != 2; ++w) {
+                std::uint64_t east = (row[w] << 1) | carry;
+                std::uint64_t west = (row[w] >> 1) | (w + 1 < words ? row[w + 1] << 63 : 0);
+                carry = row[w] >> 63;
+
+                size_t i = r * words + w;
+                std::uint64_t grown = east | west | F[i - words] | F[i + words];
+                std::uint64_t fresh = grown & free_tiles[i] & ~visited[i];
+                visited[i] |= fresh;
+                N[i] = fresh;
+                any |= fresh;
+            }
+
+            if (any) {
+                lo = std::min(lo, r);
+                hi = r;
+            }
+        }
+    }
+
+    m_next_lo = lo;
+    m_next_hi = hi;
+    return lo <= hi;
+}
+
+/**
+ * @brief One BFS step with one 128-bit register per row.
+ *
+ * Same as `expand_scalar` for rows of two words; the carry between the two halves
+ * of a shifted row moves with a byte shift of the register.
+ */
+bool BitboardBfs::expand_sse2() {
+#if defined(__SSE2__)
+    std::uint64_t* N = m_next.data();
+    const std::uint64_t* F = m_frontier.data();
+    const __m128i zero = _mm_setzero_si128();
+
+    auto load = [](const std::uint64_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); };
+    auto store = [](std::uint64_t* p, __m128i v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); };
+
+    // Clear what the buffer held two steps ago.
+    for (size_t r = m_next_lo; r <= m_next_hi; ++r) store(N + r * 2, zero);
+
+    size_t lo = m_rows + 1;
+    size_t hi = 0;
+    if (m_frontier_lo <= m_frontier_hi) {
+        size_t first = std::max<size_t>(m_frontier_lo, 2) - 1;
+        size_t last = std::min(m_frontier_hi + 1, m_rows);
+
+        for (size_t r = first; r <= last; ++r) {
+            size_t i = r * 2;
+            __m128i row = load(F + i);
+            __m128i east = _mm_or_si128(_mm_slli_epi64(row, 1), _mm_slli_si128(_mm_srli_epi64(row, 63), 8));
+            __m128i west = _mm_or_si128(_mm_srli_epi64(row, 1), _mm_srli_si128(_mm_slli_epi64(row, 63), 8));
+            __m128i grown = _mm_or_si128(_mm_or_si128(east, west), _mm_or_si128(load(F + i - 2), load(F + i + 2)));
+
+            __m128i visited = load(m_visited.data() + i);
+            __m128i fresh = _mm_andnot_si128(visited, _mm_and_si128(grown, load(m_free.data() + i)));
+            store(m_visited.data() + i, _mm_or_si128(visited, fresh));
+            store(N + i, fresh);
+
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(fresh, zero)) != 0xFFFF) {
+                lo = std::min(lo, r);
+                hi = r;
+            }
+        }
+    }
+
+    m_next_lo = lo;
+    m_next_hi = hi;
+    return lo <= hi;
+#else
+    return expand_scalar();
+#endif
+}
+
+/// @brief Counts the tiles reached by the last search.
+std::size_t BitboardBfs::count_visited() const {
+    std::size_t count = 0;
+    for (std::uint64_t word : m_visited) count += __builtin_popcountll(word);
+    return count;
+}
+
+/// @brief Finds the first move of a shortest path from a tile to the food.
+size_t BitboardBfs::search(const Level& level, size_t start, size_t& first_move, std::size_t& reached) {
+    reached = 0;
+    if (level.tiles()[level.index(level.get_food_loc())] != Level::FOOD) return 0;
+
+    prepare(level);
+
+    const size_t stride = level.stride();
+    const size_t neighbors[4] = {start - stride, start + 1, start + stride, start - 1}; // up, right, down, left
+    const bool use_sse2 = m_kernel == kernel_e::SSE2 and m_words == 2;
+
+    // Bit of every free neighbor of the start, in the bitset layout
+    size_t word[4];
+    std::uint64_t bit[4];
+    for (size_t dir = 0; dir < 4; ++dir) {
+        TilePos pos = level.position(neighbors[dir]);
+        word[dir] = (pos.row + 1) * m_words + pos.col / 64;
+        bit[dir] = std::uint64_t{1} << (pos.col % 64);
+        if (pos.row >= m_rows or pos.col >= m_cols or not (m_free[word[dir]] & bit[dir])) {
+            // Off the board (a level without an outer wall) or blocked: never matches, and stays in bounds
+            word[dir] = 0;
+            bit[dir] = 0;
+        }
+    }
+
+    // Step 0: the food
+    const TilePos food = level.get_food_loc();
+    const size_t food_word = (food.row + 1) * m_words + food.col / 64;
+    m_frontier[food_word] = m_visited[food_word] = std::uint64_t{1} << (food.col % 64);
+    m_frontier_lo = m_frontier_hi = food.row + 1;
+
+    for (size_t length = 1;; ++length) {
+        for (size_t dir = 0; dir < 4; ++dir) {
+            if (m_frontier[word[dir]] & bit[dir]) {
+                first_move = neighbors[dir];
+                reached = count_visited();
+                return length;
+            }
+        }
+
+        if (not (use_sse2 ? expand_sse2() : expand_scalar())) {
+            reached = count_visited();
+            return 0;
+        }
+
+        m_frontier.swap(m_next);
+        std::swap(m_frontier_lo, m_next_lo);
+        std::swap(m_frontier_hi, m_next_hi);
+    }
+}
@@ -0,0 +1,80 @@
+#ifndef BITBOARD_HPP
+#define BITBOARD_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Level;
+
+/**
+ * @brief Breadth-first search on row bitsets, expanding a whole frontier per step.
+ *
+ * Walls, snake and visited tiles are bitsets with one row per maze row and bit
+ * `c % 64` of word `c / 64` for column `c` (the layout of `Level::occupancy()`).
+ * A BFS step computes the next frontier of every row at once: the current frontier
+ * shifted one column left and right, OR the frontiers of the rows above and below,
+ * AND the free tiles, AND-NOT the visited ones. A step costs a few word operations
+ * per row, whatever the number of tiles in the frontier, and only the rows the
+ * frontier spans (plus their two neighbors) are visited.
+ *
+ * The search grows from the food, not from the head: the first free neighbor of
+ * the head that it reaches is the first move of a shortest path, so a single
+ * frontier is enough to recover it.
+ */
+class BitboardBfs {
+public:
+    /// @brief Implementations of the frontier expansion.
+    enum class kernel_e {
+        SCALAR,  ///< Plain 64-bit words; any level width.
+        SSE2,    ///< One 128-bit register per row; levels up to 128 columns, x86 builds only.
+    };
+
+private:
+    size_t m_rows = 0;                     ///< Maze rows; the bitsets have a zero row above and below
+    size_t m_words = 0;                    ///< Words per row (at least 2, so that the SSE2 kernel can run)
+    size_t m_cols = 0;                     ///< Maze columns
+    kernel_e m_kernel;                     ///< The expansion used by `search()`
+
+    std::vector<std::uint64_t> m_free;     ///< Open tiles not taken by the snake
+    std::vector<std::uint64_t> m_visited;  ///< Tiles reached so far
+    std::vector<std::uint64_t> m_frontier; ///< Tiles reached at the last step
+    std::vector<std::uint64_t> m_next;     ///< Tiles reached at this step
+    size_t m_frontier_lo = 1;              ///< First bitset row where `m_frontier` may be non-zero
+    size_t m_frontier_hi = 0;              ///< Last such row; below `m_frontier_lo` if the frontier is empty
+    size_t m_next_lo = 1;                  ///< Same as `m_frontier_lo`, for `m_next`
+    size_t m_next_hi = 0;                  ///< Same as `m_frontier_hi`, for `m_next`
+
+    void prepare(const Level& level);         ///< Sizes the bitsets and loads the free tiles
+    bool expand_scalar();                     ///< One step, on 64-bit words
+    bool expand_sse2();                       ///< One step, on 128-bit rows
+    std::size_t count_visited() const;        ///< Number of tiles reached so far
+
+public:
+    /// @brief Creates a search that uses the fastest kernel of the build.
+    BitboardBfs();
+
+    /// @brief Tells whether a kernel is compiled in.
+    static bool available(kernel_e kernel);
+
+    /// @brief Selects the kernel; unavailable kernels fall back to `SCALAR`.
+    void set_kernel(kernel_e kernel) { m_kernel = available(kernel) ? kernel : kernel_e::SCALAR; }
+
+    /// @brief Gets the kernel in use.
+    kernel_e kernel() const { return m_kernel; }
+
+    /**
+     * @brief Finds the first move of a shortest path from a tile to the food.
+     *
+     * The snake's body blocks the way as it is now (see `Level::occupancy()`).
+     *
+     * @param level The level, with its food and snake.
+     * @param start Index of the starting tile (see `Level::index()`).
+     * @param first_move Receives the index of the neighbor of `start` to move to.
+     * @param reached Receives the number of tiles reached by the search.
+     * @return The length of the path, or 0 if the food cannot be reached.
+     */
+    size_t search(const Level& level, size_t start, size_t& first_move, std::size_t& reached);
+};
+
+#endif
@@ -0,0 +1,55 @@
+#include "frame_clock.hpp"
+
+#include <cmath>
+#include <thread>
+
+/// @brief Creates a clock for a frame rate.
+FrameClock::FrameClock(clock::duration period, double target_fps) : m_period(period) {
+    m_timing.target_fps = target_fps;
+}
+
+/// @brief Waits for the deadline of the next frame, then moves it one period ahead.
+void FrameClock::wait() {
+    clock::time_point now = clock::now();
+    bool measured = m_running; // No interval across a resync: the time went to waiting for the player.
+
+    if (not m_running) {
+        // First frame, or first after a resync: it is due now.
+        m_deadline = now;
+        m_running = true;
+    } else if (now < m_deadline) {
+        std::this_thread::sleep_until(m_deadline);
+        now = clock::now();
+    } else {
+        ++m_timing.missed;
+        if (now - m_deadline > MAX_BACKLOG * m_period) {
+            // Too late to catch up: drop the backlog.
+            ++m_timing.resyncs;
+            m_deadline = now;
+        }
+    }
+
+    if (measured) {
+        double interval = std::chrono::duration<double, std::milli>(now - m_last_tick).count();
+        ++m_intervals;
+        double delta = interval - m_interval_mean;
+        m_interval_mean += delta / m_intervals;
+        m_interval_m2 += delta * (interval - m_interval_mean);
+        m_active_ms += interval;
+    }
+
+    ++m_timing.ticks;
+    m_last_tick = now;
+    m_deadline += m_period;
+}
+
+/// @brief Gets the pace of the loop so far.
+FrameTiming FrameClock::timing() const {
+    FrameTiming result = m_timing;
+
+    result.mean_ms = m_interval_mean;
+    result.jitter_ms = m_intervals > 1 ? std::sqrt(m_interval_m2 / (m_intervals - 1)) : 0.0;
+    result.achieved_fps = m_active_ms > 0 ? m_intervals * 1000.0 / m_active_ms : 0.0;
+
+    return result;
+}
@@ -0,0 +1,100 @@
+#ifndef FRAME_CLOCK_HPP
+#define FRAME_CLOCK_HPP
+
+#include <chrono>
+#include <cstddef>
+
+/// @brief How well the game loop kept its pace, as reported at the end of an interactive run.
+struct FrameTiming {
+    std::size_t ticks = 0;           ///< Number of frames the loop ran.
+    std::size_t missed = 0;          ///< Number of frames that started after their deadline.
+    std::size_t skipped_renders = 0; ///< Number of frames simulated without being drawn, to catch up.
+    std::size_t resyncs = 0;         ///< Number of times the loop was so late it gave up catching up.
+    double target_fps = 0.0;         ///< Frames per second asked for.
+    double achieved_fps = 0.0;       ///< Frames per second actually run (time waiting for a key excluded).
+    double mean_ms = 0.0;            ///< Mean time between two frames, in milliseconds.
+    double jitter_ms = 0.0;          ///< Standard deviation of the time between two frames, in milliseconds.
+};
+
+/**
+ * @brief Paces the game loop on absolute deadlines of a steady clock.
+ *
+ * Frame `n` is due at `start + n * period`. `wait()` sleeps until the deadline of the
+ * next frame with `sleep_until`, so the time spent thinking and drawing is part of the
+ * period instead of being added to it, and rounding errors do not accumulate. A late
+ * frame starts at once; the loop then runs back to back until it is on time again,
+ * and may skip drawing meanwhile (`behind()`). When it is more than `MAX_BACKLOG`
+ * frames late, it drops the backlog and starts over from now.
+ */
+class FrameClock {
+public:
+    using clock = std::chrono::steady_clock;
+
+private:
+    static constexpr int MAX_BACKLOG = 4; ///< Frames of delay the loop tries to catch up on.
+
+    clock::duration m_period{};           ///< Time between two frames.
+    clock::time_point m_deadline{};       ///< Deadline of the next frame.
+    clock::time_point m_last_tick{};      ///< Moment the last frame started.
+    bool m_running = false;               ///< Whether `m_deadline` and `m_last_tick` are meaningful.
+
+    FrameTiming m_timing;                 ///< Counters reported by `timing()`.
+    std::size_t m_intervals = 0;          ///< Number of measured times between two frames.
+    double m_interval_mean = 0.0;         ///< Running mean of those times, in milliseconds.
+    double m_interval_m2 = 0.0;           ///< Running sum of squared deviations (Welford).
+    double m_active_ms = 0.0;             ///< Sum of those times, in milliseconds.
+
+public:
+    FrameClock() = default;
+
+    /**
+     * @brief Creates a clock for a frame rate.
+     *
+     * @param period Time between two frames.
+     * @param target_fps The frame rate the period comes from, for the report.
+     */
+    FrameClock(clock::duration period, double target_fps);
+
+    /**
+     * @brief Waits for the deadline of the next frame, then moves it one period ahead.
+     */
+    void wait();
+
+    /**
+     * @brief Tells whether the next frame is already due, so drawing this one may be skipped.
+     *
+     * @return True if the deadline of the next frame has passed.
+     */
+    bool behind() const { return m_running and clock::now() >= m_deadline; }
+
+    /**
+     * @brief Changes the frame rate, keeping the counters.
+     *
+     * @param period New time between two frames.
+     * @param target_fps The frame rate the period comes from, for the report.
+     */
+    void set_rate(clock::duration period, double target_fps) {
+        m_period = period;
+        m_timing.target_fps = target_fps;
+        resync();
+    }
+
+    /// @brief Counts a frame that was simulated but not drawn.
+    void skip_render() { ++m_timing.skipped_renders; }
+
+    /**
+     * @brief Starts over from now, forgetting any delay.
+     *
+     * Called after waiting for the player, which is not a late frame.
+     */
+    void resync() { m_running = false; }
+
+    /**
+     * @brief Gets the pace of the loop so far.
+     *
+     * @return The counters, achieved frame rate and jitter.
+     */
+    FrameTiming timing() const;
+};
+
+#endif
@@ -0,0 +1,89 @@
+#include "frame_composer.hpp"
+
+#include <cerrno>
+#include <iostream>
+#include <unistd.h>
+
+/// @brief Appends a number in decimal.
+void FrameComposer::append_number(long value) {
+    char digits[24];
+    size_t n = 0;
+    unsigned long magnitude = value < 0 ? 0ul - static_cast<unsigned long>(value) : static_cast<unsigned long>(value);
+
+    do {
+        digits[n++] = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+    if (value < 0) digits[n++] = '-';
+
+    char* dst = grow(n);
+    while (n != 0) *dst++ = digits[--n];
+}
+
+/// @brief Appends a glyph several times.
+void FrameComposer::append_repeat(std::string_view glyph, long count) {
+    for (long i = 0; i < count; ++i) append(glyph);
+}
+
+/// @brief Appends one heart per life: full for the lives left, empty for the lives lost.
+void FrameComposer::append_lives(int lives, int max_lives) {
+    append_repeat("♥", lives);
+    append_repeat("♡", max_lives - lives);
+}
+
+/// @brief Appends the status line of the game screens, without a line break.
+void FrameComposer::append_status(const StatusLine& status) {
+    append(" Lives: ");
+    append_lives(status.lives, status.max_lives);
+    append(" | Score: ");
+    append_number(status.score);
+    append("     | Food eaten: ");
+    append_number(status.food);
+    append(" of ");
+    append_number(status.max_food);
+}
+
+/// @brief Appends a whole board, one line per row.
+void FrameComposer::append_board(const BoardView& board, const GlyphTable& glyphs) {
+    const size_t cols = board.cols;
+
+    // Every glyph padded to 4 bytes: each tile is then one fixed-size copy, and the
+    // cursor moves by the glyph's real length.
+    char packed[6][4] = {};
+    std::uint8_t length[6];
+    for (size_t t = 0; t < glyphs.size(); ++t) {
+        std::memcpy(packed[t], glyphs[t].data(), std::min<size_t>(glyphs[t].size(), 4));
+        length[t] = static_cast<std::uint8_t>(std::min<size_t>(glyphs[t].size(), 4));
+    }
+
+    // Reserve the worst case once (plus the padding of the last copy), then copy without checks.
+    size_t reserved = board.rows * (cols * 4 + 1) + 4;
+    char* dst = grow(reserved);
+    char* const start = dst;
+
+    for (size_t row = 0; row < board.rows; ++row) {
+        const std::uint8_t* line = board.row(row);
+        for (size_t col = 0; col < cols; ++col) {
+            std::memcpy(dst, packed[line[col]], 4);
+            dst += length[line[col]];
+        }
+        *dst++ = '\n';
+    }
+
+    m_size -= reserved - static_cast<size_t>(dst - start);
+}
+
+/// @brief Writes the frame to standard output with a single `write()`.
+void FrameComposer::write_out() const {
+    std::cout.flush();
+
+    std::string_view data = view();
+    while (not data.empty()) {
+        ssize_t written = ::write(STDOUT_FILENO, data.data(), data.size());
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return; // Nowhere to draw; the game goes on.
+        }
+        data.remove_prefix(static_cast<size_t>(written));
+    }
+}
@@ -0,0 +1,163 @@
+#ifndef FRAME_COMPOSER_HPP
+#define FRAME_COMPOSER_HPP
+
+#include "level.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+/// @brief Glyph (UTF-8 bytes) of every `Level::tile_type_e`, indexed by the tile's value.
+using GlyphTable = std::array<std::string_view, 6>;
+
+/// @brief Glyphs of the running game.
+inline constexpr GlyphTable GAME_GLYPHS = {" ", "█", " ", "¤", "◎", "●"};
+
+/// @brief Glyphs of the screens shown before a level starts: the food is hidden and the head marks the spawn.
+inline constexpr GlyphTable SPAWN_GLYPHS = {" ", "█", " ", " ", "๑", "●"};
+
+/// @brief Glyphs of the screen shown after a crash.
+inline constexpr GlyphTable CRASH_GLYPHS = {" ", "█", " ", "¤", "☠", "."};
+
+/// @brief Line drawn above and below the board.
+inline constexpr std::string_view SEPARATOR = "--------------------------------------------------------";
+
+/**
+ * @brief A board to draw: the padded tile array of a level, or a copy of it.
+ *
+ * Converts implicitly from `Level`, so a level can be drawn as it is now.
+ */
+struct BoardView {
+    const std::uint8_t* tiles; ///< Padded, row-major tiles, as in `Level::tiles()`.
+    size_t rows;               ///< Number of rows, without the border.
+    size_t cols;               ///< Number of columns, without the border.
+    size_t stride;             ///< Distance between two rows of `tiles`.
+
+    BoardView(const std::uint8_t* t_tiles, size_t t_rows, size_t t_cols, size_t t_stride)
+        : tiles(t_tiles), rows(t_rows), cols(t_cols), stride(t_stride) { }
+
+    /// @brief Views the tiles of a level.
+    BoardView(const Level& level)
+        : BoardView(level.tiles(), level.n_rows(), level.n_cols(), level.stride()) { }
+
+    /// @brief Gets the tiles of a row, without its border.
+    const std::uint8_t* row(size_t r) const { return tiles + (r + 1) * stride + 1; }
+};
+
+/// @brief Counters shown on the status line of the game screens.
+struct StatusLine {
+    int lives = 0;      ///< Lives left.
+    int max_lives = 0;  ///< Lives at the start of the game.
+    int score = 0;      ///< Current score.
+    int food = 0;       ///< Food eaten in the current level.
+    int max_food = 0;   ///< Food to eat to clear a level.
+
+    bool operator==(const StatusLine& other) const {
+        return lives == other.lives and max_lives == other.max_lives and score == other.score
+            and food == other.food and max_food == other.max_food;
+    }
+    bool operator!=(const StatusLine& other) const { return not (*this == other); }
+};
+
+/**
+ * @brief Builds the bytes of a screen in a buffer reused from one frame to the next.
+ *
+ * Screens are composed with the `append` family and then sent to the terminal at once
+ * with `write_out()`. The buffer only grows, so once it fits the largest screen no more
+ * allocation happens.
+ */
+class FrameComposer {
+private:
+    std::vector<char> m_buf; ///< Storage; only the first `m_size` bytes belong to the frame.
+    size_t m_size = 0;       ///< Length of the frame being composed.
+
+    /**
+     * @brief Makes room for more bytes.
+     *
+     * @param extra Number of bytes about to be appended.
+     * @return Where to write them.
+     */
+    char* grow(size_t extra) {
+        if (m_size + extra > m_buf.size()) m_buf.resize(std::max(m_buf.size() * 2, m_size + extra));
+        char* dst = m_buf.data() + m_size;
+        m_size += extra;
+        return dst;
+    }
+
+public:
+    /// @brief Starts a new frame, keeping the buffer.
+    void clear() { m_size = 0; }
+
+    /// @brief Gets the frame composed so far.
+    std::string_view view() const { return std::string_view(m_buf.data(), m_size); }
+
+    /// @brief Gets the length of the frame composed so far, in bytes.
+    size_t size() const { return m_size; }
+
+    /// @brief Appends bytes.
+    void append(std::string_view text) {
+        if (not text.empty()) std::memcpy(grow(text.size()), text.data(), text.size());
+    }
+
+    /// @brief Appends a single character.
+    void append(char ch) { *grow(1) = ch; }
+
+    /**
+     * @brief Appends a number in decimal.
+     *
+     * @param value The number.
+     */
+    void append_number(long value);
+
+    /**
+     * @brief Appends a glyph several times.
+     *
+     * @param glyph The glyph.
+     * @param count How many times.
+     */
+    void append_repeat(std::string_view glyph, long count);
+
+    /**
+     * @brief Appends the glyph of one tile.
+     *
+     * @param glyphs The glyph table.
+     * @param tile A `Level::tile_type_e` value.
+     */
+    void append_tile(const GlyphTable& glyphs, std::uint8_t tile) { append(glyphs[tile]); }
+
+    /**
+     * @brief Appends one heart per life: full for the lives left, empty for the lives lost.
+     *
+     * @param lives Lives left.
+     * @param max_lives Lives at the start of the game.
+     */
+    void append_lives(int lives, int max_lives);
+
+    /**
+     * @brief Appends the status line of the game screens, without a line break.
+     *
+     * @param status The counters to show.
+     */
+    void append_status(const StatusLine& status);
+
+    /**
+     * @brief Appends a whole board, one line per row.
+     *
+     * @param board The board, usually a `Level`.
+     * @param glyphs The glyph of every tile type.
+     */
+    void append_board(const BoardView& board, const GlyphTable& glyphs);
+
+    /**
+     * @brief Writes the frame to standard output with a single `write()`.
+     *
+     * `std::cout` is flushed first, so that anything printed through it comes before.
+     */
+    void write_out() const;
+};
+
+#endif
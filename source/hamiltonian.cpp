@@ -0,0 +1,169 @@
+#include "hamiltonian.hpp"
+#include "level.hpp"
+
+#include <algorithm>
+
+/// @brief Searches a Hamiltonian cycle over the tiles reachable from the spawn position.
+bool HamiltonianCycle::build(const Level& level, size_t budget) {
+    const std::uint8_t* tiles = level.tiles();
+    const long stride = static_cast<long>(level.stride());
+    const long offsets[4] = {-stride, 1, stride, -1}; // up, right, down, left
+    const size_t n_tiles = level.tile_count();
+
+    m_order.assign(n_tiles, NOT_ON_CYCLE);
+    m_next.assign(n_tiles, NOT_ON_CYCLE);
+    m_length = 0;
+
+    auto open_tile = [&](size_t idx) {
+        return tiles[idx] != Level::WALL and tiles[idx] != Level::INV_WALL;
+    };
+
+    // Tiles reachable from the spawn position
+    const size_t start = level.index(level.get_spawn_loc());
+    std::vector<std::uint8_t> in_set(n_tiles, 0);
+    std::vector<std::uint32_t> cells{static_cast<std::uint32_t>(start)};
+    in_set[start] = 1;
+    for (size_t k = 0; k < cells.size(); ++k) {
+        for (long offset : offsets) {
+            size_t V = cells[k] + offset;
+            if (not in_set[V] and open_tile(V)) {
+                in_set[V] = 1;
+                cells.push_back(static_cast<std::uint32_t>(V));
+            }
+        }
+    }
+
+    const size_t n_cells = cells.size();
+    if (n_cells < 4 or n_cells % 2 != 0) return false;
+
+    // Every tile needs two neighbors, and a cycle alternates the checkerboard colors.
+    size_t black = 0;
+    for (std::uint32_t idx : cells) {
+        int degree = 0;
+        for (long offset : offsets) degree += in_set[idx + offset];
+        if (degree < 2) return false;
+
+        TilePos pos = level.position(idx);
+        black += (pos.row + pos.col) % 2;
+    }
+    if (black * 2 != n_cells) return false;
+
+    // Depth-first backtracking. `visited` holds the path; the head is its last tile.
+    std::vector<std::uint8_t> visited(n_tiles, 0);
+    std::vector<std::uint32_t> path{static_cast<std::uint32_t>(start)};
+    std::vector<std::uint32_t> candidates;  // 4 slots per depth, best first
+    std::vector<std::uint8_t> n_candidates; // per depth
+    std::vector<std::uint8_t> tried;        // per depth
+    visited[start] = 1;
+
+    // Links an unvisited tile may still use: unvisited neighbors, the head, the start.
+    auto links = [&](size_t idx, size_t head) {
+        int count = 0;
+        for (long offset : offsets) {
+            size_t V = idx + offset;
+            if (in_set[V] and (not visited[V] or V == head or V == start)) ++count;
+        }
+        return count;
+    };
+
+    // Orders the moves from the current head and pushes them as a new depth.
+    auto expand = [&]() {
+        size_t head = path.back();
+        std::uint32_t moves[4];
+        int scores[4];
+        int n = 0;
+
+        for (long offset : offsets) {
+            size_t V = head + offset;
+            if (in_set[V] and not visited[V]) {
+                moves[n] = static_cast<std::uint32_t>(V);
+                scores[n] = links(V, V);
+                ++n;
+            }
+        }
+
+        // Insertion sort by remaining links (Warnsdorff's rule)
+        for (int i = 1; i < n; ++i) {
+            for (int j = i; j > 0 and scores[j] < scores[j - 1]; --j) {
+                std::swap(scores[j], scores[j - 1]);
+                std::swap(moves[j], moves[j - 1]);
+            }
+        }
+
+        for (int i = 0; i < 4; ++i) candidates.push_back(i < n ? moves[i] : 0);
+        n_candidates.push_back(static_cast<std::uint8_t>(n));
+        tried.push_back(0);
+    };
+
+    // After moving the head from `prev` to `head`, can every unvisited tile still be linked?
+    auto feasible = [&](size_t prev, size_t head) {
+        for (size_t around : {prev, head}) {
+            for (long offset : offsets) {
+                size_t V = around + offset;
+                if (in_set[V] and not visited[V] and links(V, head) < 2) return false;
+            }
+        }
+
+        // The start must keep a free neighbor to close the cycle.
+        if (path.size() < n_cells) {
+            bool can_close = false;
+            for (long offset : offsets) {
+                size_t V = start + offset;
+                if (in_set[V] and (not visited[V] or V == head)) can_close = true;
+            }
+            if (not can_close) return false;
+        }
+        return true;
+    };
+
+    auto adjacent = [&](size_t a, size_t b) {
+        size_t gap = a > b ? a - b : b - a;
+        return gap == 1 or gap == static_cast<size_t>(stride);
+    };
+
+    expand();
+    size_t steps = 0;
+    bool found = false;
+
+    while (not path.empty() and steps < budget) {
+        size_t depth = path.size() - 1;
+
+        if (path.size() == n_cells and adjacent(path.back(), start)) {
+            found = true;
+            break;
+        }
+
+        if (path.size() < n_cells and tried[depth] < n_candidates[depth]) {
+            size_t prev = path.back();
+            size_t V = candidates[depth * 4 + tried[depth]++];
+            ++steps;
+
+            visited[V] = 1;
+            path.push_back(static_cast<std::uint32_t>(V));
+
+            if (feasible(prev, V)) {
+                expand();
+            } else {
+                visited[V] = 0;
+                path.pop_back();
+            }
+            continue;
+        }
+
+        // Dead end: backtrack
+        candidates.resize(candidates.size() - 4);
+        n_candidates.pop_back();
+        tried.pop_back();
+        if (depth > 0) visited[path.back()] = 0;
+        path.pop_back();
+    }
+
+    if (not found) return false;
+
+    m_length = n_cells;
+    for (size_t k = 0; k < n_cells; ++k) {
+        m_order[path[k]] = static_cast<std::uint32_t>(k);
+        m_next[path[k]] = path[(k + 1) % n_cells];
+    }
+    return true;
+}
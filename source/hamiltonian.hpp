@@ -0,0 +1,70 @@
+#ifndef HAMILTONIAN_HPP
+#define HAMILTONIAN_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Level;
+
+/**
+ * @brief A Hamiltonian cycle over the walkable tiles of a level.
+ *
+ * The cycle visits every tile reachable from the snake's spawn position exactly
+ * once and comes back to the start. A snake that follows it can never crash, and
+ * it passes over every tile, so it eventually eats every piece of food.
+ *
+ * Tiles are identified by `Level::index()`. Lookups are O(1).
+ */
+class HamiltonianCycle {
+private:
+    std::vector<std::uint32_t> m_order; ///< Position of every tile along the cycle, or `NOT_ON_CYCLE`.
+    std::vector<std::uint32_t> m_next;  ///< Tile that follows every tile along the cycle.
+    size_t m_length = 0;                ///< Number of tiles on the cycle; 0 if there is none.
+
+public:
+    static constexpr std::uint32_t NOT_ON_CYCLE = UINT32_MAX; ///< Order of the tiles that are not on the cycle.
+
+    /**
+     * @brief Searches a Hamiltonian cycle over the tiles reachable from the spawn position.
+     *
+     * Grid graphs without a cycle are rejected upfront when possible (a tile with fewer
+     * than two walkable neighbors, or unequal numbers of tiles on the two colors of the
+     * checkerboard). Otherwise a depth-first backtracking search runs, trying first the
+     * neighbors with the fewest remaining options (Warnsdorff's rule) and pruning as soon
+     * as some unvisited tile is left with fewer than two possible links.
+     *
+     * @param level The level, as loaded (walls only matter).
+     * @param budget Maximum number of search steps before giving up.
+     * @return True if a cycle was found; otherwise the object is left empty.
+     */
+    bool build(const Level& level, size_t budget);
+
+    /// @brief Tells whether no cycle is known.
+    bool empty() const { return m_length == 0; }
+
+    /// @brief Gets the number of tiles on the cycle.
+    size_t size() const { return m_length; }
+
+    /// @brief Tells whether a tile is on the cycle.
+    bool contains(size_t idx) const { return idx < m_order.size() and m_order[idx] != NOT_ON_CYCLE; }
+
+    /// @brief Gets the position of a tile along the cycle.
+    std::uint32_t order(size_t idx) const { return m_order[idx]; }
+
+    /// @brief Gets the tile that follows another along the cycle.
+    std::uint32_t next(size_t idx) const { return m_next[idx]; }
+
+    /**
+     * @brief Counts the steps from one tile to another going forward along the cycle.
+     *
+     * @param from Index of the starting tile (on the cycle).
+     * @param to Index of the destination tile (on the cycle).
+     * @return A number between 0 and `size() - 1`.
+     */
+    size_t distance(size_t from, size_t to) const {
+        return (m_order[to] + m_length - m_order[from]) % m_length;
+    }
+};
+
+#endif
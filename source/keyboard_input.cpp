@@ -0,0 +1,86 @@
+#include "keyboard_input.hpp"
+
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+/// @brief Terminal settings before `enable()`.
+static termios saved_termios;
+
+/// @brief Whether `saved_termios` holds settings to restore.
+static volatile std::sig_atomic_t raw_mode = 0;
+
+/**
+ * @brief Restores the terminal, then lets the signal do what it would have done.
+ *
+ * @param sig The signal received.
+ */
+static void restore_and_reraise(int sig) {
+    KeyboardInput::restore();
+    std::signal(sig, SIG_DFL);
+    std::raise(sig);
+}
+
+/// @brief Switches the terminal to raw mode, if standard input is a terminal.
+void KeyboardInput::enable() {
+    if (raw_mode or not isatty(STDIN_FILENO)) return;
+    if (tcgetattr(STDIN_FILENO, &saved_termios) != 0) return;
+
+    termios raw = saved_termios;
+    raw.c_lflag &= ~(ICANON | ECHO); // Keys arrive one by one, and are not printed
+    raw.c_cc[VMIN] = 0;
+    raw.c_cc[VTIME] = 0;
+    if (tcsetattr(STDIN_FILENO, TCSAFLUSH, &raw) != 0) return;
+    raw_mode = 1;
+
+    // Whatever way the program ends, the shell gets its terminal back.
+    std::atexit(restore);
+    for (int sig : {SIGINT, SIGTERM, SIGHUP, SIGQUIT}) std::signal(sig, restore_and_reraise);
+}
+
+/// @brief Restores the terminal settings saved by `enable()`.
+void KeyboardInput::restore() {
+    if (not raw_mode) return;
+    tcsetattr(STDIN_FILENO, TCSAFLUSH, &saved_termios);
+    raw_mode = 0;
+}
+
+/// @brief Queues the keys pressed so far, waiting for one at most `timeout`.
+void KeyboardInput::poll(std::chrono::milliseconds timeout) {
+    if (m_eof) return;
+
+    // Keys already queued need no waiting.
+    int wait_ms = m_keys.empty() ? static_cast<int>(timeout.count()) : 0;
+
+    pollfd fd{STDIN_FILENO, POLLIN, 0};
+    int ready;
+    do {
+        ready = ::poll(&fd, 1, wait_ms);
+    } while (ready < 0 and errno == EINTR);
+    if (ready <= 0) return;
+
+    // One read takes every key pressed so far (or the next chunk of a pipe).
+    char buf[64];
+    ssize_t n;
+    do {
+        n = ::read(STDIN_FILENO, buf, sizeof buf);
+    } while (n < 0 and errno == EINTR);
+
+    if (n <= 0) {
+        m_eof = true;
+        return;
+    }
+    for (ssize_t i = 0; i < n; ++i) m_keys.push_back(buf[i] == '\r' ? ENTER : buf[i]);
+}
+
+/// @brief Pops the oldest queued key.
+bool KeyboardInput::next(char& key) {
+    if (m_keys.empty()) return false;
+
+    key = m_keys.front();
+    m_keys.pop_front();
+    return true;
+}
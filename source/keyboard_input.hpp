@@ -0,0 +1,65 @@
+#ifndef KEYBOARD_INPUT_HPP
+#define KEYBOARD_INPUT_HPP
+
+#include <chrono>
+#include <deque>
+
+/**
+ * @brief Reads single key presses from standard input without blocking the game loop.
+ *
+ * When standard input is a terminal, `enable()` switches it to raw mode (no line
+ * buffering, no echo), so every key is available as soon as it is pressed. The
+ * original settings are restored at exit, `exit()` calls included, and when the
+ * process is interrupted or terminated by a signal. When standard input is not a
+ * terminal (a pipe or a file), it is read as is, and a line break is an <ENTER> key.
+ *
+ * `poll()` waits, at most for a given time, for input with `poll(2)` and appends the
+ * bytes available to a queue; `next()` pops the queue. Reads never block.
+ */
+class KeyboardInput {
+private:
+    std::deque<char> m_keys;  ///< Keys read but not handled yet, oldest first.
+    bool m_eof = false;       ///< Standard input was closed.
+
+public:
+    /// @brief Byte of the <ENTER> key in raw mode.
+    static constexpr char ENTER = '\n';
+
+    /**
+     * @brief Switches the terminal to raw mode, if standard input is a terminal.
+     *
+     * Safe to call more than once.
+     */
+    static void enable();
+
+    /**
+     * @brief Restores the terminal settings saved by `enable()`.
+     *
+     * Only uses async-signal-safe calls, so that signal handlers may call it.
+     */
+    static void restore();
+
+    /**
+     * @brief Queues the keys pressed so far, waiting for one at most `timeout`.
+     *
+     * @param timeout How long to wait if no key is queued or pending; zero does not wait.
+     */
+    void poll(std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Pops the oldest queued key.
+     *
+     * @param key Receives the key.
+     * @return False if the queue is empty.
+     */
+    bool next(char& key);
+
+    /**
+     * @brief Tells whether standard input was closed.
+     *
+     * @return True once the end of input was read; no key will come anymore.
+     */
+    bool at_eof() const { return m_eof; }
+};
+
+#endif
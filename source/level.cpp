@@ -1,69 +1,110 @@
 #include "level.hpp"
 
-#include <random>
+#include <algorithm>
 
 /// @brief Constructor that initializes the maze with the given input.
 Level::Level(const std::vector<std::string> &input_maze) {
-    // Maze sizing
-    m_maze.resize(input_maze.size()); //
-    for (size_t i = 0; i < input_maze.size(); ++i) { //
-        m_maze[i].resize(input_maze[0].size()); //
-    }
+    // Maze sizing: every tile starts as a wall, which leaves the border in place.
+    m_rows = input_maze.size();
+    m_cols = input_maze[0].size();
+    m_stride = m_cols + 2;
+    m_maze.assign((m_rows + 2) * m_stride, tile_type_e::WALL);
+    m_free_slot.assign(m_maze.size(), NO_SLOT);
+    m_occ_words = (m_cols + 63) / 64;
+    m_occupancy.assign(m_rows * m_occ_words, 0);
+    m_neighbor = {-static_cast<long>(m_stride), 1, static_cast<long>(m_stride), -1}; // up, right, down, left
 
     // Filling the maze
     for (size_t i{0}; i < n_rows(); ++i) {
         for (size_t j{0}; j < n_cols(); ++j) {
+            size_t idx = index(TilePos(i, j));
+
             switch (input_maze[i][j]) {
-                case ' ':
-                    m_maze[i][j] = tile_type_e::EMPTY;
-                    break;
                 case '#':
-                    m_maze[i][j] = tile_type_e::WALL;
+                    write_tile(idx, tile_type_e::WALL);
                     break;
                 case '.':
-                    m_maze[i][j] = tile_type_e::INV_WALL;
+                    write_tile(idx, tile_type_e::INV_WALL);
                     break;
                 case '&':
                     m_spawn_loc = TilePos(i, j);
-                    m_maze[i][j]=tile_type_e::SNAKE_HEAD;
+                    write_tile(idx, tile_type_e::SNAKE_HEAD);
                     break;
-                default:
+                default: // ' ' and unknown characters
+                    write_tile(idx, tile_type_e::EMPTY);
                     break;
             }
         }
     }
 
-    // Food generation
-    place_food();
+    // Walls, as a bitset
+    m_open.assign(m_rows * m_occ_words, 0);
+    for (size_t i{0}; i < n_rows(); ++i) {
+        for (size_t j{0}; j < n_cols(); ++j) {
+            std::uint8_t tile = m_maze[index(TilePos(i, j))];
+            if (tile != tile_type_e::WALL and tile != tile_type_e::INV_WALL) {
+                m_open[i * m_occ_words + j / 64] |= std::uint64_t{1} << (j % 64);
+                ++m_n_open;
+            }
+        }
+    }
 }
 
 /// @brief Gets the number of rows in the maze.
-size_t Level::n_rows() const { return m_maze.size(); }
+size_t Level::n_rows() const { return m_rows; }
 
 /// @brief Gets the number of columns in the maze.
-size_t Level::n_cols() const { return m_maze[0].size(); }
+size_t Level::n_cols() const { return m_cols; }
 
 /// @brief Gets the type of tile at a specified position.
 Level::tile_type_e Level::get_tile_type(TilePos t_pos) const {
-    return static_cast<tile_type_e>(m_maze[t_pos.row][t_pos.col]);
+    return static_cast<tile_type_e>(m_maze[index(t_pos)]);
 }
 
 /// @brief Sets the type of tile at a specified position.
 void Level::set_tile_type(tile_type_e t_type, TilePos t_pos) {
-    m_maze[t_pos.row][t_pos.col] = t_type;
+    write_tile(index(t_pos), t_type);
+}
+
+/// @brief Writes a tile and keeps the free-tile index and the occupancy in sync.
+void Level::write_tile(size_t idx, tile_type_e t_type) {
+    bool was_free = (m_free_slot[idx] != NO_SLOT);
+    bool is_free = (t_type == tile_type_e::EMPTY);
+
+    m_maze[idx] = t_type;
+
+    TilePos t_pos = position(idx);
+    std::uint64_t& word = m_occupancy[t_pos.row * m_occ_words + t_pos.col / 64];
+    std::uint64_t bit = std::uint64_t{1} << (t_pos.col % 64);
+    if (t_type == tile_type_e::SNAKE_HEAD or t_type == tile_type_e::SNAKE_BODY) {
+        word |= bit;
+    } else {
+        word &= ~bit;
+    }
+
+    if (is_free and not was_free) {
+        m_free_slot[idx] = static_cast<std::uint32_t>(m_free_tiles.size());
+        m_free_tiles.push_back(static_cast<std::uint32_t>(idx));
+    } else if (was_free and not is_free) {
+        // Swap-remove: the last free tile takes over the vacated slot.
+        std::uint32_t slot = m_free_slot[idx];
+        std::uint32_t last = m_free_tiles.back();
+        m_free_tiles[slot] = last;
+        m_free_slot[last] = slot;
+        m_free_tiles.pop_back();
+        m_free_slot[idx] = NO_SLOT;
+    }
 }
 
 /// @brief Gets the current location of the food in the maze.
-TilePos Level::get_food_loc() const { return m_food_loc; }
+TilePos Level::get_food_loc() const { return position(m_food); }
 
 /// @brief Removes the snake's body and head from the maze grid.
 void Level::remove_snake() {
-    for (size_t i{0}; i < n_rows(); ++i) {
-        for (size_t j{0}; j < n_cols(); ++j) {
-            if (m_maze[i][j] == tile_type_e::SNAKE_HEAD 
-                    or m_maze[i][j] == tile_type_e::SNAKE_BODY) {
-                m_maze[i][j] = tile_type_e::EMPTY;
-            }
+    for (size_t w{0}; w < m_occupancy.size(); ++w) {
+        while (m_occupancy[w] != 0) {
+            size_t col = (w % m_occ_words) * 64 + __builtin_ctzll(m_occupancy[w]);
+            set_tile_type(tile_type_e::EMPTY, TilePos(w / m_occ_words, col)); // also clears the bit
         }
     }
 }
@@ -74,7 +115,7 @@ std::vector<TilePos> Level::empty_spaces() const {
 
     for (size_t i{0}; i < n_rows(); ++i) {
         for (size_t j{0}; j < n_cols(); ++j) {
-            if (m_maze[i][j] == tile_type_e::EMPTY) {
+            if (m_maze[index(TilePos(i, j))] == tile_type_e::EMPTY) {
                 vec_tiles.push_back(TilePos(i,j));
             }
         }
@@ -84,26 +125,38 @@ std::vector<TilePos> Level::empty_spaces() const {
 }
 
 /// @brief Places food at a random empty location in the maze.
-void Level::place_food() {
-    auto vec_empty_spaces = empty_spaces();
+void Level::place_food(std::mt19937& rng) {
+    if (m_maze[m_food] == tile_type_e::FOOD) write_tile(m_food, tile_type_e::EMPTY);
+    if (m_free_tiles.empty()) return;
+
+    std::uniform_int_distribution<size_t> dist(0, m_free_tiles.size() - 1);
 
-    if (vec_empty_spaces.empty()) return;
+    m_food = m_free_tiles[dist(rng)];
+    write_tile(m_food, tile_type_e::FOOD);
+    ++m_food_serial;
+}
 
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dist(0, vec_empty_spaces.size() - 1);
+/// @brief Places the first food of a run, whatever food was drawn before.
+void Level::reset_food(std::mt19937& rng) {
+    if (m_maze[m_food] == tile_type_e::FOOD) write_tile(m_food, tile_type_e::EMPTY);
 
-    m_food_loc = vec_empty_spaces[dist(gen)];
-    set_tile_type(tile_type_e::FOOD, m_food_loc);
+    // Back to tile order: the swap-removes of earlier draws left the index shuffled.
+    std::sort(m_free_tiles.begin(), m_free_tiles.end());
+    for (std::size_t slot = 0; slot < m_free_tiles.size(); ++slot) {
+        m_free_slot[m_free_tiles[slot]] = static_cast<std::uint32_t>(slot);
+    }
+
+    place_food(rng);
 }
 
 /// @brief Checks if a given position in the maze would result in a crash.
 bool Level::crashed(TilePos t_pos) const {
-    if (t_pos.row >= n_rows() or t_pos.col >= n_cols()) {
+    // No bounds check needed: off-grid neighbors land on the wall border.
+    auto t_type = get_tile_type(t_pos);
+
+    if (t_type == tile_type_e::WALL or t_type == tile_type_e::INV_WALL) {
         return true;
     }
 
-    auto t_type = get_tile_type(t_pos);
-
-    return (t_type != tile_type_e::EMPTY and t_type != tile_type_e::FOOD);
+    return is_occupied(t_pos);
 }
\ No newline at end of file
@@ -5,7 +5,9 @@
 #include "snake.hpp"
 
 #include <cstddef>
+#include <array>
 #include <cstdint>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -22,9 +24,26 @@ class Snake;
  */
 class Level {
 private:
-    std::vector<std::vector<int>> m_maze; ///< Internal representation of the maze grid.
+    std::vector<std::uint8_t> m_maze;     ///< Row-major maze grid, padded with a one-tile wall border.
+    size_t m_rows = 0;                    ///< Number of rows in the maze (without the border).
+    size_t m_cols = 0;                    ///< Number of columns in the maze (without the border).
+    size_t m_stride = 0;                  ///< Distance between two rows in `m_maze` (`m_cols + 2`).
     TilePos m_spawn_loc;                  ///< The initial spawn location for the snake in this level.
-    TilePos m_food_loc;                   ///< The current location of the food in the maze.
+    cell_t m_food = 0;                    ///< The tile of the food.
+    std::array<long, 4> m_neighbor{};     ///< Offset from a tile to its neighbor in each `direction`.
+
+    // Free-tile index, kept up to date by `set_tile_type()`.
+    std::vector<cell_t> m_free_tiles;        ///< Indices (see `index()`) of every EMPTY tile, in no particular order.
+    std::vector<std::uint32_t> m_free_slot;  ///< For each tile, its slot in `m_free_tiles`, or `NO_SLOT` if not EMPTY.
+    size_t m_food_serial = 0;                ///< Number of times food was placed so far.
+
+    // Snake occupancy, kept up to date by `set_tile_type()`.
+    std::vector<std::uint64_t> m_occupancy;  ///< One bit per tile, set where the snake's head or body is; rows of `m_occ_words` words.
+    size_t m_occ_words = 0;                  ///< Number of 64-bit words per row of `m_occupancy`.
+    std::vector<std::uint64_t> m_open;       ///< One bit per tile, set where there is no wall; same layout as `m_occupancy`.
+    size_t m_n_open = 0;                     ///< Number of tiles that are not walls.
+
+    static constexpr std::uint32_t NO_SLOT = UINT32_MAX; ///< Marks tiles that are not in the free-tile index.
 
 public:
     /**
@@ -64,6 +83,75 @@ public:
      */
     size_t n_cols() const;
 
+    /**
+     * @brief Gets the index of a position in the raw tile array.
+     *
+     * The grid is stored row-major with a one-tile `WALL` border around it, so every
+     * in-bounds position and its four neighbors have valid indices. Thanks to unsigned
+     * wrap-around, a step off any edge (e.g. row `-1`) lands on the border.
+     *
+     * @param t_pos The position, in maze coordinates.
+     * @return The index of `t_pos` in `tiles()`.
+     */
+    cell_t index(TilePos t_pos) const { return static_cast<cell_t>((t_pos.row + 1) * m_stride + (t_pos.col + 1)); }
+
+    /**
+     * @brief Gets the neighbor table: the offset to add to a tile index to step in each direction.
+     *
+     * Indexed by `direction` (up, right, down, left). Computed once per level; the
+     * planners loop over it instead of rebuilding offsets from the stride.
+     *
+     * @return The four offsets.
+     */
+    const std::array<long, 4>& neighbor_offsets() const { return m_neighbor; }
+
+    /**
+     * @brief Gets the neighbor of a tile.
+     *
+     * @param cell A tile index.
+     * @param dir The direction to step in.
+     * @return The index of the next tile in direction `dir`.
+     */
+    cell_t neighbor(cell_t cell, direction dir) const { return static_cast<cell_t>(cell + m_neighbor[static_cast<int>(dir)]); }
+
+    /**
+     * @brief Gets the distance between two vertically adjacent tiles in `tiles()`.
+     *
+     * Moving up or down is `-stride()` or `+stride()`; left or right is `-1` or `+1`.
+     *
+     * @return The number of tiles per padded row.
+     */
+    size_t stride() const { return m_stride; }
+
+    /**
+     * @brief Gives read-only access to the raw, padded tile array.
+     *
+     * Planners and renderers may walk it directly with `index()` and `stride()`,
+     * without any bounds checks: the border tiles are walls.
+     *
+     * @return A pointer to the first (border) tile of the grid.
+     */
+    const std::uint8_t* tiles() const { return m_maze.data(); }
+
+    /**
+     * @brief Gets the size of the raw tile array, border included.
+     *
+     * @return The number of tiles in `tiles()`; every `index()` is below it.
+     */
+    size_t tile_count() const { return m_maze.size(); }
+
+    /**
+     * @brief Tells whether the snake may move onto a tile of the raw array.
+     *
+     * Index-based counterpart of `crashed()`, meant for the planners' inner loops.
+     *
+     * @param idx An index returned by `index()`, or one of its four neighbors.
+     * @return True if the tile is EMPTY or FOOD.
+     */
+    bool walkable(size_t idx) const {
+        return m_maze[idx] == tile_type_e::EMPTY or m_maze[idx] == tile_type_e::FOOD;
+    }
+
     /**
      * @brief Gets the type of tile at a specified position.
      *
@@ -86,6 +174,35 @@ public:
      * @return The `TilePos` object indicating the food's coordinates.
      */
     TilePos get_food_loc() const;
+
+    /// @brief Gets the tile index of the food.
+    cell_t food_cell() const { return m_food; }
+
+    /**
+     * @brief Gets the type of a tile of the raw array.
+     *
+     * @param cell A tile index.
+     * @return Its `tile_type_e`.
+     */
+    tile_type_e tile(cell_t cell) const { return static_cast<tile_type_e>(m_maze[cell]); }
+
+    /**
+     * @brief Sets the type of a tile of the raw array.
+     *
+     * @param t_type The new type.
+     * @param cell A tile index inside the maze (not the border).
+     */
+    void set_tile(tile_type_e t_type, cell_t cell) { write_tile(cell, t_type); }
+
+    /**
+     * @brief Identifies the current piece of food.
+     *
+     * Incremented by every `place_food()`, so planners can tell when data they
+     * computed for the food is out of date.
+     *
+     * @return The number of times food was placed in this level.
+     */
+    size_t food_serial() const { return m_food_serial; }
     
     /**
      * @brief Gets the initial spawn location for the snake in this level.
@@ -94,17 +211,22 @@ public:
      */
     TilePos get_spawn_loc() const { return m_spawn_loc; }
 
+    /// @brief Gets the tile index of the spawn location.
+    cell_t spawn_cell() const { return index(m_spawn_loc); }
+
     /**
      * @brief Removes the snake's body and head from the maze grid.
      *
-     * Iterates through the entire maze and resets any `SNAKE_HEAD` or `SNAKE_BODY`
-     * tiles back to `EMPTY`.
+     * Walks the occupancy bitset and resets every `SNAKE_HEAD` or `SNAKE_BODY`
+     * tile back to `EMPTY`.
      */
     void remove_snake();
 
     /**
      * @brief Returns a vector of all empty spaces in the maze.
      *
+     * @note This scans the whole grid; `place_food()` uses the free-tile index instead.
+     *
      * @return A `std::vector` of `TilePos` objects representing all empty locations.
      */
     std::vector<TilePos> empty_spaces() const;
@@ -112,18 +234,108 @@ public:
     /**
      * @brief Places food at a random empty location in the maze.
      *
-     * If there are no empty spaces, no food is placed. This method also
-     * updates `m_food_loc` to the new food position.
+     * If the previous food is still on the board, it is removed first. If there are
+     * no empty spaces, no food is placed. This method also updates `m_food` to the
+     * new food tile. The tile is drawn uniformly from the free-tile index, so placing
+     * food costs O(1).
+     *
+     * @note A new level has no food until this is called.
+     *
+     * @param rng The generator to draw the tile with (the simulation's, so that seeded runs repeat).
      */
-    void place_food();
+    void place_food(std::mt19937& rng);
+
+    /**
+     * @brief Places the first food of a run, whatever food was drawn before.
+     *
+     * Removes the food, puts the free-tile index back in tile order and places the
+     * food. The tile then only depends on the board and on `rng`, not on the draws
+     * made before, so a level reseeded with a seed plays like a fresh one. O(n log n).
+     *
+     * @param rng The generator to draw the tile with.
+     */
+    void reset_food(std::mt19937& rng);
 
     /**
      * @brief Checks if a given position in the maze would result in a crash.
      *
      * @param t_pos The `TilePos` object representing the coordinates to check for a crash.
+     * Walls come from the tile grid and the snake from the occupancy bitset, both in O(1).
+     *
      * @return True if the position is occupied by a wall or snake body, or out of bounds; false otherwise.
      */
     bool crashed(TilePos t_pos) const;
+
+    /**
+     * @brief Tells whether the snake (head or body) is on a tile.
+     *
+     * @param t_pos An in-bounds position.
+     * @return True if the occupancy bit of `t_pos` is set.
+     */
+    bool is_occupied(TilePos t_pos) const {
+        return (m_occupancy[t_pos.row * m_occ_words + t_pos.col / 64] >> (t_pos.col % 64)) & 1u;
+    }
+
+    /**
+     * @brief Gives read-only access to the snake occupancy bitset.
+     *
+     * Row `r` starts at word `r * occupancy_words()`; column `c` is bit `c % 64`
+     * of word `c / 64` of that row.
+     *
+     * @return A pointer to the first word of the bitset.
+     */
+    const std::uint64_t* occupancy() const { return m_occupancy.data(); }
+
+    /**
+     * @brief Gets the number of 64-bit words per row of the occupancy bitset.
+     *
+     * @return The row length of `occupancy()`, in words.
+     */
+    size_t occupancy_words() const { return m_occ_words; }
+
+    /**
+     * @brief Gives read-only access to the bitset of the tiles that are not walls.
+     *
+     * Same layout as `occupancy()`. Walls never change once the level is loaded.
+     *
+     * @return A pointer to the first word of the bitset.
+     */
+    const std::uint64_t* open_tiles() const { return m_open.data(); }
+
+    /**
+     * @brief Gets the number of tiles that are not walls.
+     *
+     * @return The most tiles a snake could ever cover in this level.
+     */
+    size_t n_open_tiles() const { return m_n_open; }
+
+    /**
+     * @brief Gets the number of EMPTY tiles in the maze.
+     *
+     * @return The size of the free-tile index.
+     */
+    size_t n_free_tiles() const { return m_free_tiles.size(); }
+
+    /**
+     * @brief Converts an index of the raw tile array back to maze coordinates.
+     *
+     * @param idx An index returned by `index()`.
+     * @return The corresponding position.
+     */
+    TilePos position(std::size_t idx) const { return TilePos(idx / m_stride - 1, idx % m_stride - 1); }
+
+private:
+    /**
+     * @brief Writes a tile and keeps the free-tile index and the occupancy in sync.
+     *
+     * EMPTY tiles are appended to `m_free_tiles`; tiles that stop being EMPTY are
+     * swap-removed from it. Both operations are O(1). The occupancy bit is set for
+     * SNAKE_HEAD and SNAKE_BODY tiles and cleared for any other type.
+     *
+     * @param idx The index of the tile in `m_maze`.
+     * @param t_type The new type of the tile.
+     */
+    void write_tile(size_t idx, tile_type_e t_type);
 };
 
 #endif
\ No newline at end of file
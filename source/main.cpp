@@ -1,18 +1,30 @@
 #include "SnazeSimulation.hpp"
 
+#include <cstdlib>
+
 int main(int argc, char* argv[]) {
-  // SnazeSimulation is a singleton, meaning only one instance of it can exist.
-  // getInstance() provides access to this single instance.
-  SnazeSimulation& game = SnazeSimulation::getInstance(); 
-  
+  SnazeSimulation game;
+
   game.initialize(argc, argv);
-  
+
+  if (game.benchmarking()) return game.run_bench();
+
+  // Tournament mode: every level file against every player type and seed.
+  if (game.in_tournament()) return game.run_tournament();
+
+  // Batch mode: several independent games played in parallel.
+  if (game.jobs() > 1) return game.run_batch();
+
   // The Game Loop.
-  while (not game.is_over()) {
+  while (not game.is_over() and not game.step_limit_reached()) {
     game.process_events();
     game.update();
     game.render();
   }
 
-  return 0;
+  // Interactive runs exit from the final screen; only headless runs get here.
+  game.save_recording();
+  game.print_summary();
+
+  return game.get_states() == states::GAME_WON ? EXIT_SUCCESS : EXIT_FAILURE;
 }
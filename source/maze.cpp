@@ -2,6 +2,9 @@
 #include "level.hpp"
 #include "snake.hpp"
 
+#include <chrono>
+#include <iostream>
+
 /**
  * @brief Advances to the next level or ends the game if no more levels remain.
  * 
@@ -13,12 +16,14 @@
  *       `reset_food`, `respawn`) correctly reset the new level's elements.
  */
 void SnazeSimulation::level_up() {
+    ++levels_cleared;
+
     if (current_level_index + 1 < static_cast<int>(levels.size())) {
         ++current_level_index;
 
-        snake_obj.reset(levels[current_level_index]); // Reset the snake on the new level
+        snake_obj.reset(levels[current_level_index], rng); // Reset the snake on the new level
         reset_food();
-        print_maze_in_lv();
+        if (not headless) print_maze_in_lv();
         respawn();
 
         current_state = states::START_SCREEN;
@@ -27,19 +32,6 @@ void SnazeSimulation::level_up() {
     }
 }
 
-/**
- * @brief Returns the singleton instance of the Snaze simulation.
- * 
- * This function implements the singleton pattern, ensuring that there is only one
- * instance of `SnazeSimulation` throughout the program's execution.
- * 
- * @return SnazeSimulation& Reference to the single instance of the simulation.
- */
-SnazeSimulation& SnazeSimulation::getInstance() {
-    static SnazeSimulation instance;
-    return instance;
-}
-
 /**
  * @brief Updates the game score based on collected food.
  * 
@@ -97,3 +89,29 @@ void SnazeSimulation::reset_food() {
 //     }
 //     std::cout << "------------------" << '\n';
 // }
+
+/**
+ * @brief Searches the Hamiltonian cycle of every level, for the HAMILTONIAN player.
+ *
+ * Runs once at startup, so the snake only has to look up the next tile of the
+ * cycle at every move. Levels without a cycle (or where the search ran out of
+ * budget) fall back to the survival player.
+ */
+void SnazeSimulation::precompute_cycles(bool report) {
+    constexpr std::size_t budget = 2'000'000; // search steps per level
+
+    cycles.assign(levels.size(), HamiltonianCycle{});
+
+    for (std::size_t i = 0; i < levels.size(); ++i) {
+        auto build_start = std::chrono::steady_clock::now();
+        bool found = cycles[i].build(levels[i], budget);
+        std::chrono::duration<double, std::milli> build_time = std::chrono::steady_clock::now() - build_start;
+
+        // On the error stream: standard output only holds the run summary.
+        if (not report) continue;
+        std::cerr << "level=" << i
+                  << " hamiltonian=" << (found ? "found" : "none")
+                  << " cells=" << cycles[i].size()
+                  << " precompute_ms=" << build_time.count() << "\n";
+    }
+}
@@ -0,0 +1,58 @@
+#include "montecarlo.hpp"
+#include "level.hpp"
+
+#include <algorithm>
+#include <random>
+
+/// @brief Plays one random game continuation and scores it.
+double rollout(RolloutState& state, const RolloutSetup& setup, size_t first_move, std::uint64_t seed, size_t& steps) {
+    const long stride = static_cast<long>(setup.stride);
+    const long offsets[4] = {-stride, 1, stride, -1}; // up, right, down, left
+    const std::vector<std::uint32_t>& field = *setup.food_field;
+
+    std::minstd_rand rng{static_cast<std::uint32_t>(seed ^ (seed >> 32)) | 1u};
+    std::uint8_t* tiles = state.tiles.data();
+    bool ate = false;
+    size_t ate_at = 0;
+    size_t next = first_move;
+
+    for (steps = 0; steps < setup.horizon; ++steps) {
+        if (steps > 0) {
+            // Pick the next move among the free neighbors of the head.
+            size_t head = state.body.back();
+            size_t options[4];
+            int n = 0;
+            for (long offset : offsets) {
+                size_t V = head + offset;
+                if (tiles[V] == Level::EMPTY or tiles[V] == Level::FOOD) options[n++] = V;
+            }
+            if (n == 0) break; // trapped
+
+            if (not ate) {
+                // Keep only the neighbors closest to the food.
+                std::uint32_t least = field[options[0]];
+                for (int i = 1; i < n; ++i) least = std::min(least, field[options[i]]);
+
+                int closest = 0;
+                for (int i = 0; i < n; ++i) {
+                    if (field[options[i]] == least) options[closest++] = options[i];
+                }
+                n = closest;
+            }
+            next = options[rng() % n];
+        }
+
+        // Move: the head enters `next`; the tail follows unless the snake eats.
+        if (next == setup.food and not ate) {
+            ate = true;
+            ate_at = steps;
+        } else {
+            tiles[state.body[state.tail]] = Level::EMPTY;
+            ++state.tail;
+        }
+        tiles[next] = Level::SNAKE_HEAD;
+        state.body.push_back(static_cast<std::uint32_t>(next));
+    }
+
+    return static_cast<double>(steps) + (ate ? static_cast<double>(setup.horizon - ate_at) : 0.0);
+}
@@ -0,0 +1,54 @@
+#ifndef MONTECARLO_HPP
+#define MONTECARLO_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief A copy of the game state that a rollout plays on.
+ *
+ * Only what the simulated moves touch is kept: the grid bytes and the body tiles,
+ * so a snapshot is two flat buffers. Copying it into a state that already has the
+ * capacity performs no allocation.
+ */
+struct RolloutState {
+    std::vector<std::uint8_t> tiles;   ///< The grid, as `Level::tiles()`
+    std::vector<std::uint32_t> body;   ///< Body tiles from `tail` on, tail first; the moves of the rollout are appended
+    size_t tail = 0;                   ///< Position of the tail in `body`
+
+    /// @brief Copies another state, reusing the buffers of this one.
+    void copy_from(const RolloutState& other) {
+        tiles.assign(other.tiles.begin(), other.tiles.end());
+        body.assign(other.body.begin() + other.tail, other.body.end());
+        tail = 0;
+    }
+};
+
+/// @brief Fixed inputs of the rollouts of one decision.
+struct RolloutSetup {
+    const std::vector<std::uint32_t>* food_field;  ///< Distance from every tile to the food (see `Snake::build_food_field`)
+    size_t stride;                                 ///< Distance between two vertically adjacent tiles
+    size_t food;                                   ///< Tile of the food
+    size_t horizon;                                ///< Maximum number of moves of a rollout
+};
+
+/**
+ * @brief Plays one random game continuation and scores it.
+ *
+ * Until it eats, the snake walks down the food's distance field, picking at random
+ * among the free neighbors closest to the food (so the rollouts of a move spread
+ * over the equally short routes); after the meal it moves to random free neighbors,
+ * to see whether it can survive. The score is the number of moves survived,
+ * plus, if the food was eaten, the number of moves left when it was.
+ *
+ * @param state The state to play on; it is modified.
+ * @param setup The inputs shared by the rollouts.
+ * @param first_move The tile the head moves to first (a free neighbor of the head).
+ * @param seed Seed of the rollout's own generator.
+ * @param steps Receives the number of moves played.
+ * @return The score, between 0 and `2 * horizon`.
+ */
+double rollout(RolloutState& state, const RolloutSetup& setup, size_t first_move, std::uint64_t seed, size_t& steps);
+
+#endif
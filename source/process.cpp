@@ -1,35 +1,49 @@
 #include "SnazeSimulation.hpp"
 #include "level.hpp"
 #include "snake.hpp"
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 /**
  * @brief Processes user input to control the game state transitions.
  * 
- * Reads a line of input from the user and changes the game state accordingly:
- * - If on the START_SCREEN or LEVEL_UP state and the input is empty (Enter pressed),
+ * Reads the keys pressed by the player and changes the game state accordingly:
+ * - If on the START_SCREEN or LEVEL_UP state and Enter is pressed,
  *   the state changes to SNAKE_THINKING to start or continue the game.
  * - If on the SNAKE_CRASHED state and Enter is pressed, respawns the snake and
  *   updates the game state depending on remaining lives.
  * 
- * @note This function only reacts to empty input lines (pressing Enter).
+ * @note This function only reacts to Enter, and waits at most 50ms for it, so the
+ *       loop never stalls. The end of input counts as Enter. In headless mode no
+ *       input is read and every prompt is confirmed.
  */
 void SnazeSimulation::input_process(){
-    std::string input;
-    std::getline(std::cin, input);
+    // Headless runs auto-confirm every prompt, as if <ENTER> had been pressed.
+    if (not headless) {
+        // Wait a little for a key, then let the loop go on; other keys are ignored.
+        keyboard.poll(std::chrono::milliseconds(50));
+        bool confirmed = keyboard.at_eof(); // Like an empty line at the end of input
+        for (char key; not confirmed and keyboard.next(key); ) confirmed = (key == KeyboardInput::ENTER);
+        if (not confirmed) return;
+
+        frame_clock.resync(); // Time spent waiting for the player is not a late frame.
+    }
+    prompt_drawn = false; // The next prompt is a new one
+
     
-    if(current_state == states::START_SCREEN and input.empty()){
+    if(current_state == states::START_SCREEN){
         //enter do state screen
         current_state=states::SNAKE_THINKING;
         return;
 
     }
-    if(current_state == states::LEVEL_UP and input.empty()){
+    if(current_state == states::LEVEL_UP){
         // enter do level up
         current_state=states::SNAKE_THINKING;
         return;
 
     }
-     if(current_state == states::SNAKE_CRASHED and input.empty()){
+     if(current_state == states::SNAKE_CRASHED){
         respawn();
         if (current_life == 0) {
             current_state = states::GAME_OVER;
@@ -39,6 +53,56 @@ void SnazeSimulation::input_process(){
     }
 }
 
+/**
+ * @brief Handles the keys pressed while the game runs or is paused.
+ * 
+ * - `p` or space pauses the game, or resumes it;
+ * - `s`, while paused, plays a single frame and pauses again;
+ * - `+` and `-` double and halve the frame rate (between 1 and 1000 frames per second).
+ * 
+ * Other keys are ignored. Called once per frame while the game runs, and in a loop
+ * while it is paused.
+ * 
+ * @param timeout How long to wait for a key if none is pending.
+ */
+void SnazeSimulation::process_hotkeys(std::chrono::milliseconds timeout){
+    // The frame asked for with `s` has been played.
+    if (step_once and current_state == states::SNAKE_THINKING) {
+        step_once = false;
+        current_state = states::PAUSED;
+    }
+
+    keyboard.poll(timeout);
+
+    for (char key; keyboard.next(key); ) {
+        switch (key) {
+            case 'p':
+            case ' ':
+                if (current_state == states::PAUSED) {
+                    current_state = states::SNAKE_THINKING;
+                    frame_clock.resync(); // The pause is not a late frame.
+                } else {
+                    current_state = states::PAUSED;
+                }
+                break;
+            case 's':
+                if (current_state == states::PAUSED) {
+                    step_once = true;
+                    current_state = states::SNAKE_THINKING;
+                    frame_clock.resync();
+                }
+                break;
+            case '+':
+            case '-':
+                fps = (key == '+') ? std::min(fps * 2, 1000) : std::max(fps / 2, 1);
+                frame_clock.set_rate(frame_budget(), fps);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
 /**
  * @brief Handles collision and food consumption events in the simulation.
  * 
@@ -56,6 +120,7 @@ void SnazeSimulation::input_process(){
 void SnazeSimulation::input_colision(bool food, bool colision){
     if (food==true){
         ++current_food;
+        ++food_eaten;
         update_score();
         snake_obj.found_foods = false;
 
@@ -87,7 +152,7 @@ void SnazeSimulation::input_colision(bool food, bool colision){
 void SnazeSimulation::respawn(){
     
         levels[current_level_index].remove_snake();
-        snake_obj.reset(levels[current_level_index]);
+        snake_obj.reset(levels[current_level_index], rng);
         snake_obj.collision =false;
         TilePos spawn = levels[current_level_index].get_spawn_loc();
         head_pos = spawn;
@@ -97,16 +162,142 @@ void SnazeSimulation::respawn(){
 /**
 * @brief Executes the snake's thought, calculating its next move.
 * 
-* The function calls the snake's breadth-first search method (`breadthFirst_search`),
-* which determines the next step based on the current maze and its head position.
+* The snake first follows the path it cached during its last search. Only when
+* there is none left, or it is no longer valid, does it search again (`plan_path`)
+* from its head position.
+* If the food is unreachable it falls back to a random move (`troca`). Whatever the
+* player type, a next step onto the food is reported through `input_colision`.
 * 
 * @note The next move calculation is done for the current level stored in `levels`.
+* Decisions, searches and thinking time are added to the level's `ThinkStats`.
 */
 void SnazeSimulation::snake_thinking(){
+    auto think_start = std::chrono::steady_clock::now();
+    auto deadline = think_start + frame_budget();
+    Level& level = levels[current_level_index];
+    ThinkStats& stats = level_stats[current_level_index];
+
+    cell_t head = level.index(head_pos);
+    cell_t next;
     if (player_type == player_type_e::RANDOM) {
-        SnazeSimulation& sin = SnazeSimulation::getInstance();
-        sin.troca();
+        troca();
+    } else if (snake_obj.follow_path(level, head, next)) {
+        next_pos = level.position(next);
     } else {
-        snake_obj.breadthFirst_search(levels[current_level_index], head_pos, next_pos);
+        std::size_t nodes_before = snake_obj.nodes_expanded;
+        std::size_t pruned_before = snake_obj.nodes_pruned;
+        std::size_t probes_before = snake_obj.cache_probes;
+        std::size_t hits_before = snake_obj.cache_hits;
+        ++stats.plans;
+        if (plan_path(head, next, deadline)) {
+            next_pos = level.position(next);
+        } else {
+            troca(); // If it didn't find a path, change it to random.
+        }
+        stats.nodes += snake_obj.nodes_expanded - nodes_before;
+        stats.pruned += snake_obj.nodes_pruned - pruned_before;
+        stats.cache_probes += snake_obj.cache_probes - probes_before;
+        stats.cache_hits += snake_obj.cache_hits - hits_before;
+    }
+
+    auto think_end = std::chrono::steady_clock::now();
+    ++stats.decisions;
+    stats.think_ms += std::chrono::duration<double, std::milli>(think_end - think_start).count();
+    stats.budget_ms += std::chrono::duration<double, std::milli>(frame_budget()).count();
+    if (think_end > deadline) ++stats.overruns;
+
+    // Every decided move is recorded, the one onto the last food of a level included:
+    // that one is never played, but the replay decides it too.
+    if (not record_path.empty()) {
+        for (direction d : {direction::up, direction::right, direction::down, direction::left}) {
+            if (move(head_pos, d) == next_pos) replay_log.push(d);
+        }
+    }
+
+    if (current_state == states::SNAKE_THINKING and next_pos == level.get_food_loc()) {
+        input_colision(true, snake_obj.collision); // found food
+    }
+}
+
+/**
+* @brief Takes the snake's next move from the replay log instead of thinking.
+* 
+* A tick where no neighbor of the head is free is a lost life whatever the player
+* (the AI falls back to `troca`, which finds no direction), so it was not recorded
+* and is found again here. Running out of moves before the game is over means the
+* replay went another way than the recorded game.
+*/
+void SnazeSimulation::replay_thinking(){
+    Level& level = levels[current_level_index];
+
+    bool stuck = true;
+    for (direction d : {direction::up, direction::right, direction::down, direction::left}) {
+        if (snake_obj.is_valid_position(move(head_pos, d), level)) stuck = false;
+    }
+    if (stuck) {
+        input_colision(false, true);
+        return;
     }
-}
\ No newline at end of file
+
+    direction d;
+    if (not replay_log.next(d)) {
+        replay_diverged = true;
+        current_state = states::GAME_OVER;
+        return;
+    }
+    next_dir = d;
+    next_pos = move(head_pos, d);
+
+    if (next_pos == level.get_food_loc()) {
+        input_colision(true, snake_obj.collision); // found food
+    }
+}
+
+/**
+* @brief Runs the search of the selected player type from the snake's head.
+* 
+* @param head The tile of the snake's head.
+* @param next Receives the tile of the first step, if a path is found.
+* @param deadline Moment the move must be decided by. Only the anytime player looks at
+* it; the others stop when their search is done, whatever the time.
+* 
+* @return true If a path to the food was found; `next` holds its first step.
+* @return false If the food is unreachable.
+*/
+bool SnazeSimulation::plan_path(cell_t head, cell_t& next, std::chrono::steady_clock::time_point deadline){
+    Level& level = levels[current_level_index];
+
+    switch (player_type) {
+        case player_type_e::BACKTRACKING:
+            return snake_obj.backtracking_search(level, head, next, node_budget);
+        case player_type_e::ASTAR:
+            return snake_obj.astar_search(level, head, next);
+        case player_type_e::BIDIRECTIONAL:
+            return snake_obj.bidirectional_search(level, head, next);
+        case player_type_e::FIELD:
+            return snake_obj.field_search(level, head, next);
+        case player_type_e::SURVIVAL:
+            return snake_obj.survival_search(level, head, next);
+        case player_type_e::BITBOARD:
+            return snake_obj.bitboard_search(level, head, next);
+        case player_type_e::MONTE_CARLO:
+            return snake_obj.montecarlo_search(level, head, next, *rollout_pool, n_rollouts);
+        case player_type_e::ANYTIME:
+            return snake_obj.anytime_search(level, head, next, deadline);
+        case player_type_e::HAMILTONIAN:
+            if (cycles[current_level_index].empty()) {
+                return snake_obj.survival_search(level, head, next);
+            }
+            return snake_obj.hamiltonian_search(level, head, next, cycles[current_level_index]);
+        default:
+            return snake_obj.breadthFirst_search(level, head, next);
+    }
+}
+/**
+* @brief Gets the time a frame lasts, which is the time the AI has to decide a move.
+* 
+* @return `1 / fps` seconds, in the clock's own resolution (no rounding to milliseconds).
+*/
+std::chrono::steady_clock::duration SnazeSimulation::frame_budget() const {
+    return std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / fps));
+}
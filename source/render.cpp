@@ -1,31 +1,24 @@
 #include "SnazeSimulation.hpp"
 #include "level.hpp"
+#include "replay_log.hpp"
 #include "snake.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <ostream>
+#include <random>
 #include <sstream>
 #include <string_view>
-#include <unordered_map>
+#include <thread>
+#include <utility>
 #include <vector>
 namespace fs = std::filesystem;
 
-/**
- * @brief A static `unordered_map` that maps `Level::tile_type_e` enum values
- * to their corresponding string representations (characters) for console rendering.
- */
-std::unordered_map<Level::tile_type_e , std::string> tile_2_char = {
-  {Level::tile_type_e::EMPTY, " "},
-  {Level::tile_type_e::WALL, "█"},
-  {Level::tile_type_e::INV_WALL, " "},
-  {Level::tile_type_e::FOOD, "¤"},
-  {Level::tile_type_e::SNAKE_BODY, "●"},
-  {Level::tile_type_e::SNAKE_HEAD, "◎"},
-};
-
 /**
  * @brief Prints the usage information for the Snaze game or an error message and exits.
  *
@@ -43,7 +36,25 @@ Game simulation options:
 --fps <num> Number of frames (board) presented per second.
 --lives <num> Number of lives the snake shall have. Default = 5.
 --food <num> Number of food pellets for the entire simulation. Default = 10.
---playertype <type> Type of snake intelligence: random, backtracking. Default = backtracking.
+--playertype <type> Type of snake intelligence: random, backtracking, bfs, astar, bidirectional, field, survival, hamiltonian, anytime, montecarlo, bitboard. Default = backtracking.
+--nodes <num> Moves the backtracking player may try per search. Default = 20000.
+--rollouts <num> Rollouts per legal move of the montecarlo player. Default = 64.
+--threads <num> Threads playing the montecarlo rollouts. Default = one per hardware thread.
+--async-render Draw the frames on a separate thread, dropping the ones a slow terminal cannot keep up with.
+--headless Run as fast as possible, without rendering or keyboard input, and print a summary at the end.
+--jobs <num> Play <num> independent headless games in parallel and aggregate their results. Default = 1.
+--bench Time the snake planner on every level of the input file instead of playing.
+--seed <num> Seed of every random choice (food, random moves), to repeat a game. Default = a random seed.
+--record <file> Write the moves of the game to <file>, to replay it.
+--replay <file> Play the moves recorded in <file> again, headless, and check the game ends with the last one.
+--tournament <types> Play every input file with every comma-separated player type (or all) and seed, and print a table of the runs.
+--seeds <num> Seeds every tournament pairing is played with, from --seed on. Default = 5.
+--max-steps <num> Moves after which a headless, batch or tournament run is stopped (result=capped), for levels it cannot finish. Default = 50000.
+--format <csv|json> Format of the tournament tables. Default = csv.
+Keys while the game runs:
+p or <SPACE> Pause or resume.
+s Play a single frame while paused.
++ and - Double or halve the frame rate.
 )";
 
     exit(EXIT_SUCCESS);
@@ -110,15 +121,53 @@ std::vector<std::string> tokenizer(const std::string &str,
   return output;
 }
 
+/// @brief Command-line name of every player type.
+static constexpr std::pair<std::string_view, player_type_e> PLAYER_NAMES[] = {
+  {"random", player_type_e::RANDOM},
+  {"backtracking", player_type_e::BACKTRACKING},
+  {"bfs", player_type_e::BFS},
+  {"astar", player_type_e::ASTAR},
+  {"bidirectional", player_type_e::BIDIRECTIONAL},
+  {"field", player_type_e::FIELD},
+  {"survival", player_type_e::SURVIVAL},
+  {"hamiltonian", player_type_e::HAMILTONIAN},
+  {"anytime", player_type_e::ANYTIME},
+  {"montecarlo", player_type_e::MONTE_CARLO},
+  {"bitboard", player_type_e::BITBOARD},
+};
+
+/// @brief Gets the command-line name of a player type.
+std::string_view player_name(player_type_e type) {
+  for (const auto& [name, value] : PLAYER_NAMES) {
+    if (value == type) return name;
+  }
+  return "unknown";
+}
+
+/// @brief Reads a player type from its command-line name.
+bool parse_player_type(std::string_view name, player_type_e& type) {
+  for (const auto& [player, value] : PLAYER_NAMES) {
+    if (player == name) {
+      type = value;
+      return true;
+    }
+  }
+  return false;
+}
+
 /// @brief Parses a file to load level data.
 void SnazeSimulation::parse_file(const char *file_path) {
   std::ifstream file(file_path);
   std::string line;
 
   std::vector<std::string> lines;
+  std::size_t first_level = levels.size();
 
   while (std::getline(file, line)) {
     lines.push_back(line);
+    // Replay logs check they are played on the same levels.
+    level_hash = fnv1a(line, level_hash);
+    level_hash = fnv1a("\n", level_hash);
   }
 
   for (long unsigned int i = 0; i < lines.size(); ++i) {
@@ -163,6 +212,8 @@ void SnazeSimulation::parse_file(const char *file_path) {
 
     i += n_rows;
   }
+
+  level_files.push_back(LevelFile{file_path, first_level, levels.size() - first_level});
 }
 
 /// @brief Initializes the simulation based on command line arguments.
@@ -182,7 +233,6 @@ void SnazeSimulation::initialize(int argc, char *argv[]) {
       }
 
       fps = std::stoi(next_arg);
-      std::cout << fps << '\n';
 
       ++i;
       continue;
@@ -194,7 +244,6 @@ void SnazeSimulation::initialize(int argc, char *argv[]) {
       }
 
       n_lives = std::stoi(next_arg);
-      std::cout << n_lives << '\n';
 
       ++i;
       continue;
@@ -206,22 +255,154 @@ void SnazeSimulation::initialize(int argc, char *argv[]) {
       }
 
       n_food = std::stoi(next_arg);
-      std::cout << n_food << '\n';
 
       ++i;
       continue;
     } else if (arg == "--playertype" and i + 1 < argc) {
+      if (not parse_player_type(argv[i + 1], player_type)) {
+        usage("Error: invalid player type.");
+      }
+
+      ++i;
+      continue;
+    } else if (arg == "--nodes" and i + 1 < argc) {
+      std::string next_arg = argv[i + 1];
+
+      if (!verifies_natural_number(next_arg) || std::stoi(next_arg) == 0) {
+        usage("Error: invalid node budget.");
+      }
+
+      node_budget = std::stoul(next_arg);
+
+      ++i;
+      continue;
+    } else if (arg == "--rollouts" and i + 1 < argc) {
+      std::string next_arg = argv[i + 1];
+
+      if (!verifies_natural_number(next_arg) || std::stoi(next_arg) == 0) {
+        usage("Error: invalid number of rollouts.");
+      }
+
+      n_rollouts = std::stoul(next_arg);
+
+      ++i;
+      continue;
+    } else if (arg == "--threads" and i + 1 < argc) {
+      std::string next_arg = argv[i + 1];
+
+      if (!verifies_natural_number(next_arg) || std::stoi(next_arg) == 0) {
+        usage("Error: invalid number of threads.");
+      }
+
+      n_threads = std::stoul(next_arg);
+
+      ++i;
+      continue;
+    } else if (arg == "--headless") {
+      headless = true;
+      continue;
+    } else if (arg == "--async-render") {
+      async_render = true;
+      continue;
+    } else if (arg == "--bench") {
+      bench = true;
+      continue;
+    } else if (arg == "--seed" and i + 1 < argc) {
+      std::string next_arg = argv[i + 1];
+
+      if (!verifies_natural_number(next_arg) || next_arg.size() > 9) {
+        usage("Error: invalid seed.");
+      }
+
+      seed = static_cast<std::uint32_t>(std::stoul(next_arg));
+      seeded = true;
+
+      ++i;
+      continue;
+    } else if (arg == "--record" and i + 1 < argc) {
+      record_path = argv[i + 1];
+
+      ++i;
+      continue;
+    } else if (arg == "--replay" and i + 1 < argc) {
+      if (not replay_log.load(argv[i + 1])) {
+        usage("Error: unable to read the replay log.");
+      }
+      replaying = true;
+      // Replays are checked, not watched.
+      headless = true;
+
+      ++i;
+      continue;
+    } else if (arg == "--tournament" and i + 1 < argc) {
       std::string next_arg = argv[i + 1];
 
-      if (next_arg == "random") {
-        player_type = player_type_e::RANDOM;
-      } else if (next_arg == "backtracking") {
-        // Do nothing.
-        // Using default inicialization.
+      tournament_players.clear();
+      if (next_arg == "all") {
+        for (const auto& [name, type] : PLAYER_NAMES) tournament_players.push_back(type);
       } else {
-        usage("Error: invalid player type.");
+        for (const std::string& name : tokenizer(next_arg, ",")) {
+          player_type_e type;
+          if (not parse_player_type(name, type)) {
+            usage("Error: invalid player type in the tournament.");
+          }
+          tournament_players.push_back(type);
+        }
+      }
+      if (tournament_players.empty()) {
+        usage("Error: invalid player type in the tournament.");
+      }
+      // Tournaments are measured, not watched.
+      headless = true;
+
+      ++i;
+      continue;
+    } else if (arg == "--seeds" and i + 1 < argc) {
+      std::string next_arg = argv[i + 1];
+
+      if (!verifies_natural_number(next_arg) || next_arg.size() > 9 || std::stoi(next_arg) == 0) {
+        usage("Error: invalid number of seeds.");
+      }
+
+      n_seeds = std::stoi(next_arg);
+
+      ++i;
+      continue;
+    } else if (arg == "--max-steps" and i + 1 < argc) {
+      std::string next_arg = argv[i + 1];
+
+      if (!verifies_natural_number(next_arg) || next_arg.size() > 18 || std::stoull(next_arg) == 0) {
+        usage("Error: invalid number of steps.");
+      }
+
+      max_steps = std::stoull(next_arg);
+
+      ++i;
+      continue;
+    } else if (arg == "--format" and i + 1 < argc) {
+      std::string_view next_arg = argv[i + 1];
+
+      if (next_arg == "json") {
+        json_output = true;
+      } else if (next_arg == "csv") {
+        json_output = false;
+      } else {
+        usage("Error: invalid output format.");
+      }
+
+      ++i;
+      continue;
+    } else if (arg == "--jobs" and i + 1 < argc) {
+      std::string next_arg = argv[i + 1];
+
+      if (!verifies_natural_number(next_arg) || std::stoi(next_arg) == 0) {
+        usage("Error: invalid number of jobs.");
       }
 
+      n_jobs = std::stoi(next_arg);
+      // Batch games are never rendered.
+      if (n_jobs > 1) headless = true;
+
       ++i;
       continue;
     } else {
@@ -234,7 +415,7 @@ void SnazeSimulation::initialize(int argc, char *argv[]) {
 
         out << "Sorry, unable to read \"" << std::string(argv[i]) << "\".\n";
 
-        std::cout << out.str();
+        std::cerr << out.str();
 
         exit(EXIT_FAILURE);
       }
@@ -245,168 +426,287 @@ void SnazeSimulation::initialize(int argc, char *argv[]) {
         usage("Error: no valid levels were loaded.");
       }
 
+      level_stats.assign(levels.size(), ThinkStats{});
+
       head_pos = levels[current_level_index].get_spawn_loc();
       dir = direction::right;
       levels[current_level_index].set_tile_type(Level::tile_type_e::SNAKE_HEAD, head_pos);
-      snake_obj.init(head_pos);
+      snake_obj.init(levels[current_level_index], head_pos);
     }
   }
-}
-
-/// @brief Prints the welcome screen to the console.
-void SnazeSimulation::print_welcome() {
-    std::ostringstream out;
-  
-    out << " --->  Welcome to the classic Snake Game  <--- \n"
-        << "        copyright DIMAp/UFRN 2017-2025\n"
-        << "--------------------------------------------------------\n"
-        << " Levels loaded: " << levels.size() << " | Snake lives: " << n_lives << " | Apples to eat: " << n_food << "\n"
-        << " Clear all levels to win the game. Good luck!!!\n"
-        << "--------------------------------------------------------\n"
-        << " >>> Press <ENTER> to start the game!\n\n"
-        << " Lives: ";
-
-    for (auto i = 0; i < n_lives; ++i) out << "♥";
-
-    out << " | Score: 0     | Food eaten: 0  of " << n_food << "\n"; 
-    out << "--------------------------------------------------------\n\n";
-
-    for (size_t i = 0; i < levels[current_level_index].n_rows(); ++i) {
-        for (size_t j = 0; j < levels[current_level_index].n_cols(); ++j) {
-            if (TilePos(i, j) == levels[current_level_index].get_spawn_loc()) {
-                out << "๑";
-            } else {
-                Level::tile_type_e type = levels[current_level_index].get_tile_type(TilePos(i, j));
-                if (type == Level::tile_type_e::FOOD) {
-                  out << " ";
-                } else {
-                  out << tile_2_char[type];
-                }
-            }
-        }
-        out << '\n';
-    }
 
-    out << "\n--------------------------------------------------------\n";  
+  if (levels.empty()) {
+    usage("Error: no valid levels were loaded.");
+  }
 
-    std::cout << out.str();
-}
+  if (replaying and (not record_path.empty() or n_jobs > 1 or in_tournament())) {
+    usage("Error: a replay is played alone, and cannot be recorded again.");
+  }
 
-/// @brief Prints the maze, likely for a specific level.
-void SnazeSimulation::print_maze_in_lv(){
-    std::ostringstream out;
-  
-    std::cout << ">>> Level up! Press <ENTER> to try again.\n";
-    out << "  \n";
-
-    for (auto i = 0; i < current_life; ++i) out << "♥";
-    for (auto i = 0; i < n_lives - current_life; ++i) out << "♡";
-
-    out << " | Score: " << score << "     | Food eaten: 0  of " << n_food << "\n"; 
-    out << "--------------------------------------------------------\n\n";
-
-    for (size_t i = 0; i < levels[current_level_index].n_rows(); ++i) {
-        for (size_t j = 0; j < levels[current_level_index].n_cols(); ++j) {
-            if (TilePos(i, j) == levels[current_level_index].get_spawn_loc()) {
-                out << "๑";
-            } else {
-                Level::tile_type_e type = levels[current_level_index].get_tile_type(TilePos(i, j));
-                if (type == Level::tile_type_e::FOOD) {
-                  out << " ";
-                } else {
-                  out << tile_2_char[type];
-                }
-            }
-        }
-        out << '\n';
+  // A replay brings its own seed and rules, and must be played on the levels it was recorded on.
+  if (replaying) {
+    if (replay_log.level_hash != level_hash) {
+      usage("Error: the replay log was recorded on other levels.");
     }
+    seed = replay_log.seed;
+    n_lives = replay_log.lives;
+    n_food = replay_log.food;
+    player_type = static_cast<player_type_e>(replay_log.player_type);
+  } else if (not seeded) {
+    seed = std::random_device{}();
+  }
+  current_life = n_lives;
+  // Batch games and tournament runs seed their own copies, from levels that never had
+  // any food: each of them then plays exactly like a single run with its seed.
+  if (not in_tournament() and n_jobs == 1) reseed(seed);
+
+  if (not record_path.empty()) {
+    replay_log = ReplayLog{};
+    replay_log.level_hash = level_hash;
+    replay_log.seed = seed;
+    replay_log.player_type = static_cast<std::uint8_t>(player_type);
+    replay_log.lives = static_cast<std::uint16_t>(n_lives);
+    replay_log.food = static_cast<std::uint16_t>(n_food);
+  }
+
+  // Options may come after the level files: only now is the player type known.
+  // A replay does not think, so it needs neither the cycles nor the rollout threads.
+  // Tournament maps search their own cycles, see `run_tournament()`.
+  if (player_type == player_type_e::HAMILTONIAN and not replaying and not in_tournament()) precompute_cycles();
+  bool montecarlo_in_tournament = std::find(tournament_players.begin(), tournament_players.end(), player_type_e::MONTE_CARLO) != tournament_players.end();
+  if ((player_type == player_type_e::MONTE_CARLO and not replaying) or montecarlo_in_tournament) {
+    rollout_pool = std::make_shared<WorkStealingPool>(n_threads ? n_threads : std::thread::hardware_concurrency());
+  }
 
-    out << "\n--------------------------------------------------------\n";  
+  if (async_render and not headless) presenter = std::make_shared<AsyncPresenter>();
+  if (not headless) KeyboardInput::enable();
+  frame_clock = FrameClock(frame_budget(), fps);
 
-    std::cout << out.str();
+  start_time = std::chrono::steady_clock::now();
 }
 
-/// @brief Prints the current maze to the console.
-void SnazeSimulation::print_maze() {
-  std::ostringstream out;
-
-  out << " Lives: ";
+/// @brief Waits for the render thread and marks the board for a full redraw.
+void SnazeSimulation::claim_terminal() {
+  if (presenter) {
+    presenter->drain();
+    presenter->invalidate();
+  }
+  renderer.invalidate();
+}
 
-  for (auto i = 0; i < current_life; ++i) out << "♥";
-  for (auto i = 0; i < n_lives - current_life; ++i) out << "♡";
+/// @brief Gets the counters of the status line.
+StatusLine SnazeSimulation::status_line() const {
+  return StatusLine{current_life, n_lives, score, current_food, n_food};
+}
 
+/// @brief Prints the welcome screen to the console.
+void SnazeSimulation::print_welcome() {
+  screen.clear();
+
+  screen.append(" --->  Welcome to the classic Snake Game  <--- \n"
+                "        copyright DIMAp/UFRN 2017-2025\n");
+  screen.append(SEPARATOR);
+  screen.append("\n Levels loaded: ");
+  screen.append_number(static_cast<long>(levels.size()));
+  screen.append(" | Snake lives: ");
+  screen.append_number(n_lives);
+  screen.append(" | Apples to eat: ");
+  screen.append_number(n_food);
+  screen.append("\n Clear all levels to win the game. Good luck!!!\n");
+  screen.append(SEPARATOR);
+  screen.append("\n >>> Press <ENTER> to start the game!\n\n Lives: ");
+  screen.append_repeat("♥", n_lives);
+  screen.append(" | Score: 0     | Food eaten: 0  of ");
+  screen.append_number(n_food);
+  screen.append('\n');
+  screen.append(SEPARATOR);
+  screen.append("\n\n");
+
+  // Before the game starts, the snake is only its head, on the spawn tile.
+  screen.append_board(levels[current_level_index], SPAWN_GLYPHS);
+
+  screen.append('\n');
+  screen.append(SEPARATOR);
+  screen.append('\n');
+
+  screen.write_out();
+}
 
-  out << " | Score: " << score << "     | Food eaten: " << current_food << " of " << n_food << '\n'
-      << "--------------------------------------------------------\n\n";
+/// @brief Prints the maze, likely for a specific level.
+void SnazeSimulation::print_maze_in_lv(){
+  screen.clear();
+
+  screen.append(">>> Level up! Press <ENTER> to try again.\n  \n");
+  screen.append_lives(current_life, n_lives);
+  screen.append(" | Score: ");
+  screen.append_number(score);
+  screen.append("     | Food eaten: 0  of ");
+  screen.append_number(n_food);
+  screen.append('\n');
+  screen.append(SEPARATOR);
+  screen.append("\n\n");
+
+  // The new level has not been played yet: its snake is the head on the spawn tile.
+  screen.append_board(levels[current_level_index], SPAWN_GLYPHS);
+
+  screen.append('\n');
+  screen.append(SEPARATOR);
+  screen.append('\n');
+
+  claim_terminal();
+  screen.write_out();
+}
 
-  for (size_t i = 0; i < levels[current_level_index].n_rows(); ++i) {
-      for (size_t j = 0; j < levels[current_level_index].n_cols(); ++j) {
-          Level::tile_type_e type = levels[current_level_index].get_tile_type(TilePos(i, j));
-          out << tile_2_char[type];
-      }
-      out << '\n';
+/// @brief Prints the current maze to the console.
+void SnazeSimulation::print_maze() {
+  if (presenter) {
+    presenter->publish(levels[current_level_index], status_line());
+  } else {
+    renderer.present(levels[current_level_index], status_line());
   }
-
-  out << "\n--------------------------------------------------------\n";
-
-  std::cout << out.str();
   current_state = states::SNAKE_THINKING; 
 
 }
 
 /// @brief Prints the "snake crashed" message.
 void SnazeSimulation::print_snake_crashed() {
-  std::ostringstream out;
-
-  out << " Lives: ";
+  screen.clear();
 
-  for (auto i = 0; i < current_life; ++i) out << "♥";
-  for (auto i = 0; i < n_lives - current_life; ++i) out << "♡";
+  screen.append_status(status_line());
+  screen.append('\n');
+  screen.append(SEPARATOR);
+  screen.append("\n\n");
 
-  out << " | Score: " << score << "     | Food eaten: " << current_food << " of " << n_food << '\n'
-      << "--------------------------------------------------------\n\n";
+  screen.append_board(levels[current_level_index], CRASH_GLYPHS);
 
-  for (size_t i = 0; i < levels[current_level_index].n_rows(); ++i) {
-      for (size_t j = 0; j < levels[current_level_index].n_cols(); ++j) {
-          Level::tile_type_e type = levels[current_level_index].get_tile_type(TilePos(i, j));
-          if (type == Level::tile_type_e::SNAKE_HEAD) {
-            out << "☠";
-          } else if (type == Level::tile_type_e::SNAKE_BODY) {
-            out << '.';
-          } else {
-            out << tile_2_char[type];
-          }
-      }
-      out << '\n';
-  }
+  screen.append('\n');
+  screen.append(SEPARATOR);
+  screen.append("\n>>> Press <ENTER> to try again.\n");
 
-  out << "\n--------------------------------------------------------\n"
-      << ">>> Press <ENTER> to try again.\n";
-
-  std::cout << out.str();
+  claim_terminal(); // The board scrolls up under this screen: redraw it in full next time.
+  screen.write_out();
 }
 
 /// @brief Prints the "level up" message.
 void SnazeSimulation::print_level_up() {
+  claim_terminal();
   std::cout << ">>> Press <ENTER> to try again.\n";
 }
 
 /// @brief Prints the "game won" message.
 void SnazeSimulation::print_game_won() {
+  claim_terminal();
   std::cout << R"(+-------------------------------------+
 |    CONGRATULATIONS anaconda WON!    |
 |        Thanks for playing!          |
 +-------------------------------------+
 )";
+  print_frame_stats();
+  save_recording();
   exit(EXIT_SUCCESS);
 }
 
 /// @brief Prints the "game over" message.
 void SnazeSimulation::print_game_over() {
+  claim_terminal();
   std::cout << R"(+-------------------------------------+
 |        Sorry, anaconda LOST :(      |
 |        Thanks for playing!          |
 +-------------------------------------+
 )";
+  print_frame_stats();
+  save_recording();
   exit(EXIT_FAILURE);
-}
\ No newline at end of file
+}
+
+/// @brief Prints how well the game loop kept its pace, and the render thread's counters.
+void SnazeSimulation::print_frame_stats() {
+  FrameTiming timing = frame_clock.timing();
+
+  std::cout << "fps_target=" << timing.target_fps
+            << " fps_achieved=" << timing.achieved_fps
+            << " frame_ms=" << timing.mean_ms
+            << " jitter_ms=" << timing.jitter_ms
+            << " ticks=" << timing.ticks
+            << " missed_deadlines=" << timing.missed
+            << " skipped_renders=" << timing.skipped_renders
+            << " resyncs=" << timing.resyncs << '\n';
+
+  if (not presenter) return;
+
+  presenter->stop();
+  std::cout << "frames_simulated=" << presenter->simulated()
+            << " frames_presented=" << presenter->presented()
+            << " frames_dropped=" << presenter->dropped() << '\n';
+}
+
+/// @brief Collects the statistics of the run so far.
+RunSummary SnazeSimulation::summary() const {
+  RunSummary result;
+  std::chrono::duration<double, std::milli> wall_time = std::chrono::steady_clock::now() - start_time;
+
+  result.won = (current_state == states::GAME_WON);
+  result.capped = not result.won and current_state != states::GAME_OVER and step_limit_reached();
+  result.score = score;
+  result.lives = current_life;
+  result.steps = n_steps;
+  result.levels_cleared = levels_cleared;
+  result.food = food_eaten;
+  result.deaths = n_lives - current_life;
+  result.wall_ms = wall_time.count();
+  result.seed = seed;
+  for (const ThinkStats& stats : level_stats) result.thinking += stats;
+
+  return result;
+}
+
+/// @brief Writes a run summary as space-separated `key=value` pairs.
+std::ostream& operator<<(std::ostream& os, const RunSummary& result) {
+  return os << "result=" << (result.won ? "won" : result.capped ? "capped" : "lost")
+            << " seed=" << result.seed
+            << " score=" << result.score
+            << " lives=" << result.lives
+            << " steps=" << result.steps
+            << " levels_cleared=" << result.levels_cleared
+            << " food=" << result.food
+            << " deaths=" << result.deaths
+            << " food_per_life=" << static_cast<double>(result.food) / std::max(1, result.deaths + (result.lives > 0 ? 1 : 0))
+            << " wall_ms=" << result.wall_ms
+            << " decisions=" << result.thinking.decisions
+            << " plans=" << result.thinking.plans
+            << " nodes=" << result.thinking.nodes
+            << " prune_rate=" << (result.thinking.nodes ? static_cast<double>(result.thinking.pruned) / result.thinking.nodes : 0.0)
+            << " cache_hit_rate=" << (result.thinking.cache_probes ? static_cast<double>(result.thinking.cache_hits) / result.thinking.cache_probes : 0.0)
+            << " nodes_per_plan=" << (result.thinking.plans ? static_cast<double>(result.thinking.nodes) / result.thinking.plans : 0.0)
+            << " nodes_per_decision=" << (result.thinking.decisions ? static_cast<double>(result.thinking.nodes) / result.thinking.decisions : 0.0)
+            << " think_ms=" << result.thinking.think_ms
+            << " budget_ms=" << result.thinking.budget_ms
+            << " budget_use=" << (result.thinking.budget_ms > 0 ? result.thinking.think_ms / result.thinking.budget_ms : 0.0)
+            << " overruns=" << result.thinking.overruns
+            << " decisions_per_sec=" << (result.thinking.think_ms > 0 ? result.thinking.decisions * 1000.0 / result.thinking.think_ms : 0.0);
+}
+
+/// @brief Prints a single machine-readable line summarizing the run.
+void SnazeSimulation::print_summary() {
+  std::cout << summary() << '\n';
+
+  for (size_t id = 0; id < level_stats.size(); ++id) {
+    std::cout << "level=" << id
+              << " decisions=" << level_stats[id].decisions
+              << " plans=" << level_stats[id].plans
+              << " nodes=" << level_stats[id].nodes
+              << " pruned=" << level_stats[id].pruned
+              << " cache_hits=" << level_stats[id].cache_hits
+              << " think_ms=" << level_stats[id].think_ms
+              << " budget_ms=" << level_stats[id].budget_ms
+              << " overruns=" << level_stats[id].overruns << '\n';
+  }
+
+  // A replay matches when the game ended on the last recorded move, and not before.
+  if (replaying) {
+    bool match = not replay_diverged and replay_log.position() == replay_log.size();
+    std::cout << "replay=" << (match ? "match" : "diverged")
+              << " moves=" << replay_log.size()
+              << " played=" << replay_log.position() << '\n';
+  }
+}
@@ -0,0 +1,97 @@
+#include "replay_log.hpp"
+
+#include <fstream>
+#include <iterator>
+
+/// @brief First bytes of every replay log.
+static constexpr char MAGIC[4] = {'S', 'N', 'Z', '1'};
+
+/// @brief Size of the header, up to the packed moves.
+static constexpr std::size_t HEADER_SIZE = 4 + 8 + 4 + 1 + 2 + 2 + 4;
+
+/// @brief Hashes bytes with 64-bit FNV-1a.
+std::uint64_t fnv1a(std::string_view data, std::uint64_t hash) {
+    for (unsigned char byte : data) {
+        hash ^= byte;
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+/**
+ * @brief Appends an unsigned integer, little-endian.
+ *
+ * @param out The buffer.
+ * @param value The value.
+ * @param bytes How many of its low bytes to write.
+ */
+static void put_le(std::string& out, std::uint64_t value, std::size_t bytes) {
+    for (std::size_t i = 0; i < bytes; ++i) out += static_cast<char>((value >> (8 * i)) & 0xff);
+}
+
+/**
+ * @brief Reads an unsigned integer, little-endian.
+ *
+ * @param in The bytes, from the integer on.
+ * @param bytes How many bytes it takes.
+ * @return The value.
+ */
+static std::uint64_t get_le(const char* in, std::size_t bytes) {
+    std::uint64_t value = 0;
+    for (std::size_t i = 0; i < bytes; ++i) value |= static_cast<std::uint64_t>(static_cast<unsigned char>(in[i])) << (8 * i);
+    return value;
+}
+
+/// @brief Appends a move.
+void ReplayLog::push(direction dir) {
+    if (m_count % 4 == 0) m_moves.push_back(0);
+    m_moves.back() |= static_cast<std::uint8_t>(static_cast<int>(dir) << (2 * (m_count % 4)));
+    ++m_count;
+}
+
+/// @brief Reads the next move.
+bool ReplayLog::next(direction& dir) {
+    if (m_cursor == m_count) return false;
+
+    dir = static_cast<direction>((m_moves[m_cursor / 4] >> (2 * (m_cursor % 4))) & 3);
+    ++m_cursor;
+    return true;
+}
+
+/// @brief Writes the log to a file.
+bool ReplayLog::save(const std::string& path) const {
+    std::string header(MAGIC, sizeof MAGIC);
+    put_le(header, level_hash, 8);
+    put_le(header, seed, 4);
+    put_le(header, player_type, 1);
+    put_le(header, lives, 2);
+    put_le(header, food, 2);
+    put_le(header, m_count, 4);
+
+    std::ofstream file(path, std::ios::binary);
+    file.write(header.data(), static_cast<std::streamsize>(header.size()));
+    file.write(reinterpret_cast<const char*>(m_moves.data()), static_cast<std::streamsize>(m_moves.size()));
+    return static_cast<bool>(file);
+}
+
+/// @brief Reads a log written by `save()`.
+bool ReplayLog::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    if (bytes.size() < HEADER_SIZE or bytes.compare(0, sizeof MAGIC, MAGIC, sizeof MAGIC) != 0) return false;
+
+    const char* in = bytes.data() + sizeof MAGIC;
+    level_hash = get_le(in, 8);
+    seed = static_cast<std::uint32_t>(get_le(in + 8, 4));
+    player_type = static_cast<std::uint8_t>(get_le(in + 12, 1));
+    lives = static_cast<std::uint16_t>(get_le(in + 13, 2));
+    food = static_cast<std::uint16_t>(get_le(in + 15, 2));
+    m_count = get_le(in + 17, 4);
+
+    if (bytes.size() - HEADER_SIZE != (m_count + 3) / 4) return false;
+
+    m_moves.assign(bytes.begin() + HEADER_SIZE, bytes.end());
+    m_cursor = 0;
+    return true;
+}
@@ -0,0 +1,85 @@
+#ifndef REPLAY_LOG_HPP
+#define REPLAY_LOG_HPP
+
+#include "snake.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Hashes bytes with 64-bit FNV-1a.
+ *
+ * @param data The bytes.
+ * @param hash The hash of the bytes before `data`, to hash several pieces as one.
+ * @return The hash of everything so far.
+ */
+std::uint64_t fnv1a(std::string_view data, std::uint64_t hash = 0xcbf29ce484222325ull);
+
+/**
+ * @brief The moves of a game, with what is needed to play them again.
+ *
+ * A seeded game is deterministic once its moves are known: the food only depends on
+ * the seed and on where the snake went. So a replay needs the levels (checked with a
+ * hash of the level files), the seed, the rules (lives and food per level) and one
+ * `direction` per move, packed 2 bits per move.
+ *
+ * File layout, little-endian: the magic `SNZ1`, the level hash (8 bytes), the seed
+ * (4 bytes), the player type (1 byte, informative), the lives and the food per level
+ * (2 bytes each), the number of moves (4 bytes) and then the moves, four per byte,
+ * the first one in the lowest bits.
+ */
+class ReplayLog {
+private:
+    std::vector<std::uint8_t> m_moves; ///< Packed moves.
+    std::size_t m_count = 0;           ///< Number of moves recorded.
+    std::size_t m_cursor = 0;          ///< Next move `next()` returns.
+
+public:
+    std::uint64_t level_hash = 0;      ///< Hash of the level files the game was played on.
+    std::uint32_t seed = 0;            ///< Seed of the simulation's generator.
+    std::uint8_t player_type = 0;      ///< `player_type_e` of the recorded game.
+    std::uint16_t lives = 0;           ///< Lives of the snake.
+    std::uint16_t food = 0;            ///< Food to eat per level.
+
+    /**
+     * @brief Appends a move.
+     *
+     * @param dir The direction the head moved in.
+     */
+    void push(direction dir);
+
+    /**
+     * @brief Reads the next move.
+     *
+     * @param dir Receives the direction.
+     * @return False once every move was read.
+     */
+    bool next(direction& dir);
+
+    /// @brief Gets the number of moves.
+    std::size_t size() const { return m_count; }
+
+    /// @brief Gets the number of moves `next()` has returned.
+    std::size_t position() const { return m_cursor; }
+
+    /**
+     * @brief Writes the log to a file.
+     *
+     * @param path The file.
+     * @return False if the file could not be written.
+     */
+    bool save(const std::string& path) const;
+
+    /**
+     * @brief Reads a log written by `save()`.
+     *
+     * @param path The file.
+     * @return False if the file could not be read or is not a replay log.
+     */
+    bool load(const std::string& path);
+};
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef SEARCH_SCRATCH_HPP
+#define SEARCH_SCRATCH_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Reusable working memory for grid searches.
+ *
+ * Holds a visited marker, a predecessor, a path cost and a ring queue slot for every
+ * tile of a level, all indexed by `Level::index()`. The buffers only grow, so once they are
+ * sized for the largest level a search performs no heap allocation at all.
+ *
+ * The visited marker is a generation stamp: a tile is visited if its stamp equals
+ * the current epoch, so starting a new search (`prepare()`) clears every marker in O(1).
+ */
+struct SearchScratch {
+    std::vector<std::uint32_t> stamp;  ///< Epoch in which each tile was last visited.
+    std::vector<std::uint32_t> pred;   ///< Tile from which each visited tile was reached.
+    std::vector<std::uint32_t> queue;  ///< Storage of the ring queue.
+    std::vector<std::uint32_t> cost;   ///< Best known path cost to each visited tile (A*).
+    std::uint32_t epoch = 0;           ///< Stamp of the current search.
+    size_t head = 0;                   ///< Ring queue read position.
+    size_t tail = 0;                   ///< Ring queue write position.
+    size_t count = 0;                  ///< Number of queued tiles.
+
+    /**
+     * @brief Starts a new search over `n_tiles` tiles.
+     *
+     * Grows the buffers if needed, empties the queue and forgets every visited mark.
+     *
+     * @param n_tiles The number of tiles of the level (see `Level::tile_count()`).
+     */
+    void prepare(size_t n_tiles) {
+        if (stamp.size() < n_tiles) {
+            stamp.assign(n_tiles, 0);
+            pred.resize(n_tiles);
+            queue.resize(n_tiles);
+            cost.resize(n_tiles);
+            epoch = 0;
+        }
+
+        if (++epoch == 0) { // Wrapped around: old stamps could look current again.
+            std::fill(stamp.begin(), stamp.end(), 0);
+            epoch = 1;
+        }
+
+        head = tail = count = 0;
+    }
+
+    /// @brief Tells whether a tile was visited in the current search.
+    bool visited(size_t idx) const { return stamp[idx] == epoch; }
+
+    /// @brief Marks a tile as visited in the current search.
+    void visit(size_t idx) { stamp[idx] = epoch; }
+
+    /// @brief Tells whether the ring queue is empty.
+    bool empty() const { return count == 0; }
+
+    /// @brief Appends a tile to the ring queue. At most `queue.size()` tiles may be queued at once.
+    void push(size_t idx) {
+        queue[tail] = static_cast<std::uint32_t>(idx);
+        if (++tail == queue.size()) tail = 0;
+        ++count;
+    }
+
+    /// @brief Removes and returns the oldest tile of the ring queue.
+    size_t pop() {
+        size_t idx = queue[head];
+        if (++head == queue.size()) head = 0;
+        --count;
+        return idx;
+    }
+};
+
+#endif
@@ -2,73 +2,122 @@
 #include "snake.hpp"
 #include "level.hpp"
 #include "SnazeSimulation.hpp"
+#include "hamiltonian.hpp"
+#include "thread_pool.hpp"
 #include "tile_pos.hpp"
 
 #include <algorithm>
+#include <cstdint>
 #include <deque> 
 #include <optional>
-#include <queue>
 #include <random>
-#include <unordered_map>
 #include <vector>
 
 
 
 
+/**
+* @brief Reseeds the snake's random number generator.
+* 
+* @param seed New seed for the generator used by `search_random` and the Monte Carlo rollouts.
+*/
+void Snake::seed(std::uint32_t seed) {
+    rng.seed(seed);
+}
+
 /**
 * @brief Initializes the snake with the starting head position.
 * 
 * This function clears any previous body of the snake and positions the head
 * at the provided starting position.
 * 
+* @param level The level the snake starts in; sizes the body.
 * @param start_pos Starting position for the snake's head.
 */
-void Snake::init(TilePos start_pos) {
-    body.clear();
+void Snake::init(const Level& level, TilePos start_pos) {
+    clear_path();
+    field_serial = 0;
+    body.reset(level.n_open_tiles(), level.stride());
     body.push_front(start_pos);
 }
 /**
 * @brief Reconstructs the food's path to the start to define the next move.
 * 
-* Given the search result (the `main` map that maps each position to the previous one),
-* this function traverses the path from the food's position to the starting position (`start`)
-* to determine the snake's next move.
+* Given the search result (the scratch predecessor array, which maps each visited tile
+* to the previous one), this function traverses the path from the food's tile (or any
+* other target tile) back to the starting tile (`start_idx`). The whole path is cached in `path` for `follow_path`, and
+* its first step becomes the snake's next move.
 * 
 * @param next_move Reference to store the snake's next move.
-* @param achei Flag indicating whether the food was found (true) or not (false).
-* @param food_pos Position of the food found in the maze.
-* @param main Map that relates each position to the previous position in the path.
-* @param level Reference to the current level (used for map dimensions).
-* @param start Starting position (snake's head) from which the search begins. * 
-* @note If the food was not found (`found == false`), the next move will be the current position (start).
+* @param food_idx Index of the food found in the maze (see `Level::index()`).
+* @param start_idx Index of the starting position (snake's head) from which the search begins.
+* @param level Reference to the current level (used to convert indices back to positions).
+* 
+* @note If the food is on the starting tile, the next move is the food's position.
 */
-void Snake::found_food(TilePos& next_move, bool& achei, TilePos& food_pos, std::unordered_map<size_t, TilePos>& main,Level& level, TilePos& start){
-        if(achei){
-        TilePos curr=food_pos;
+void Snake::found_food(cell_t& next_move, size_t food_idx, size_t start_idx, const Level& level){
+    path.clear();
 
-        if (main.find(food_pos.row * level.n_cols() + food_pos.col) == main.end()) {
-            next_move = food_pos;
-            return;
-        }
+    for (size_t curr = food_idx; curr != start_idx; curr = scratch.pred[curr]) {
+        path.push_back(static_cast<std::uint32_t>(curr));
+    }
+    if (path.empty()) path.push_back(static_cast<std::uint32_t>(food_idx));
 
-        while (true) {
-            TilePos anterior = main[curr.row * level.n_cols() + curr.col];
-            if (anterior.row == start.row and anterior.col == start.col) {
-                next_move = curr;
-                return;
-            }
-            curr = anterior;
-        }
-    }else {
-        next_move = start;
+    std::reverse(path.begin(), path.end());
+    path_pos = 1;
+    path_food = level.food_cell();
+
+    next_move = static_cast<cell_t>(path.front());
+}
+
+/**
+* @brief Takes the next move of the path cached by the last search.
+* 
+* Between two meals the cached shortest path stays valid: the head walks along it
+* and the tail only frees tiles. The path is dropped, and a new search is needed,
+* when it has been fully used, when the food has moved since it was planned, or
+* when its next tile is not a free neighbor of the head.
+* 
+* @param level Reference to the current level.
+* @param head_pos Current position of the snake's head.
+* @param next_move Reference to store the snake's next move.
+* 
+* @return true If `next_move` was taken from the cached path.
+* @return false If there is no usable cached path.
+*/
+bool Snake::follow_path(const Level& level, cell_t head, cell_t& next_move){
+    if (path_pos >= path.size() or path_food != level.food_cell()) {
+        clear_path();
+        return false;
+    }
+
+    size_t next = path[path_pos];
+    size_t gap = next > head ? next - head : head - next;
+
+    if ((gap != 1 and gap != level.stride()) or not level.walkable(next)) {
+        clear_path();
+        return false;
     }
+
+    ++path_pos;
+    next_move = static_cast<cell_t>(next);
+    return true;
+}
+
+/**
+* @brief Forgets the cached path, so the next decision runs a new search.
+*/
+void Snake::clear_path(){
+    path.clear();
+    path_pos = 0;
 }
 
 /**
 * @brief Checks if a position is valid for the snake to move.
 * 
 * The function checks if the passed position is not a wall and also
-* if it is not occupied by any segment of the snake's body.
+* if it is not occupied by any segment of the snake's body. The body check
+* is a single lookup in the level's occupancy bitset, whatever the snake's length.
 * 
 * @param pos Position to be checked.
 * @param level Reference to the current level, to query the tile type.
@@ -76,20 +125,15 @@ void Snake::found_food(TilePos& next_move, bool& achei, TilePos& food_pos, std::
 * @return true If the position is valid for movement (not a wall and not a body).
 * @return false Otherwise.
 * 
-* @note The function assumes that the position is within the level's boundaries.
+* @note The function assumes that the position is within the level's boundaries
+* or on its wall border.
 */
 bool Snake::is_valid_position(const TilePos& pos, Level& level) {
     if (level.get_tile_type(pos) == Level::WALL) {
         return false;
     }
 
-    for (const TilePos& segment : body) {
-        if (segment == pos) {
-            return false;
-        }
-    }
-
-    return true;
+    return not level.is_occupied(pos);
 }
 /**
 * @brief Randomly searches for a valid direction to move the snake.
@@ -103,8 +147,8 @@ bool Snake::is_valid_position(const TilePos& pos, Level& level) {
 * 
 * @return std::optional<direction> The valid direction found, or std::nullopt if none.
 * 
-* @note The function uses a static random number generator to ensure
-* variation in attempts between calls.
+* @note The function uses the snake's own random number generator, so
+* independent simulations never share random state.
 */
 std::optional<direction> Snake::search_random(TilePos head_pos, Level& level) {
     // Vector with possible directions
@@ -112,12 +156,7 @@ std::optional<direction> Snake::search_random(TilePos head_pos, Level& level) {
         direction::up, direction::right, direction::down, direction::left
     };
 
-     ///@{ Static generators for consistent randomness
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    ///}@
-
-    std::shuffle(directions.begin(), directions.end(), gen);
+    std::shuffle(directions.begin(), directions.end(), rng);
 
     for (direction dir : directions) {
         TilePos next = move(head_pos, dir);
@@ -171,71 +210,883 @@ TilePos move(TilePos current_pos, direction dir){
 * The function performs a breadth-first search from the starting position (`start`)
 * to try to find the food's position in the maze (`level`). If the food
 * is found, it defines the next move (`next_move`) based on the shortest route.
-* If no route is found, it delegates control to an alternative strategy
-* (via `SnazeSimulation::switch()`).
 * 
 * @param level Reference to the current game level, containing the maze.
 * @param start Current position of the snake's head.
 * @param next_move Reference to where the next calculated move will be stored.
 * 
-* @note The function modifies the internal state of `found_foods` and `collision`. If the food
-* is reached directly, it also signals this to `SnazeSimulation` with
-* `input_colision(true, ...)`.
+* @return true If a path to the food was found and `next_move` was set.
+* @return false If the food is unreachable; the caller decides on a fallback strategy.
+* 
+* @note The function modifies the internal state of `found_foods` and `collision`. It does not
+* touch the simulation: reacting to the result is up to the caller. All working memory
+* (visited stamps, predecessors and queue) lives in `scratch`, so once it has been sized
+* for the level a search performs no heap allocation.
 */
-void Snake::breadthFirst_search(Level& level, TilePos start,TilePos& next_move) {
-    std::queue<TilePos> fila;
-    std::vector<std::vector<bool>> visit(level.n_rows(), std::vector<bool>(level.n_cols(), false)); /// Marks visited positions in the maze
-    std::unordered_map<size_t, TilePos> main; // Maps each position to the previous position, used to reconstruct the path
-    TilePos food_pos;
-
-    SnazeSimulation& sin = SnazeSimulation::getInstance();
-    if (sin.get_states() != states::SNAKE_THINKING) return;
+bool Snake::breadthFirst_search(Level& level, cell_t start, cell_t& next_move) {
+    const std::uint8_t* tiles = level.tiles();
+    const auto& offsets = level.neighbor_offsets(); // up, right, down, left
 
     found_foods = false;
     collision = false;
 
     /// Starts the BFS at the current position
-    fila.push(start);
-    visit[start.row][start.col]=true;
+    size_t start_idx = start;
+    size_t food_idx = start_idx;
+    scratch.prepare(level.tile_count());
+    scratch.visit(start_idx);
+    scratch.push(start_idx);
 
-    while(not fila.empty()){
-        TilePos curr = fila.front();
-        fila.pop();
+    while(not scratch.empty()){
+        size_t curr = scratch.pop();
+        ++nodes_expanded;
 
-        /// Only perform the search if the snake is in the appropriate state
-        if(level.get_tile_type(curr)==Level::FOOD){
-            food_pos = curr;
+        if(tiles[curr]==Level::FOOD){
+            food_idx = curr;
             found_foods =true;
             break;
         }
 
-        for(int i=0;i<4;++i){
-            TilePos V(curr.row+drow[i], curr.col+dcol[i]);
+        for(long offset : offsets){
+            size_t V = curr + offset;
+
+            // The wall border keeps V inside the grid: only visited and collision checks are needed.
+            if(not scratch.visited(V) and level.walkable(V)){
+                scratch.visit(V);
+                scratch.pred[V] = static_cast<std::uint32_t>(curr);
+                scratch.push(V);
+            }
+        }
+    }
+
+    if (found_foods) {
+        found_food(next_move, food_idx, start_idx, level);
+    }
+    return found_foods;
+} 
+
+/**
+* @brief Depth-first branch and bound search over snake states.
+* 
+* Unlike the other planners, which search the grid as it is now, this one moves a
+* virtual snake: the tail frees a tile at every step, so paths through tiles that
+* the body only leaves later are found too. Moves are tried closest to the food
+* first, and the best path found so far bounds the rest of the search: a branch is
+* cut as soon as its length plus the Manhattan distance to the food cannot beat it.
+* 
+* A transposition table, keyed by a Zobrist hash of the body tiles and the head,
+* cuts the branches that reach a state already reached in as few moves. The hash
+* ignores the order of the body segments, so two rare states that only differ in
+* it are merged: this may miss a path, never produce a wrong one.
+* 
+* The search stops after `budget` moves, or at `deadline`, and keeps the best path
+* found so far. If it found none, the breadth-first search decides instead. Since
+* every path found is shorter than the previous one, stopping at any time yields
+* the best answer for the time spent.
+* 
+* @param level Reference to the current game level, containing the maze.
+* @param start Current position of the snake's head.
+* @param next_move Reference to where the next calculated move will be stored.
+* @param budget Maximum number of moves to try.
+* @param deadline Moment the search must stop at; checked every few hundred moves.
+* 
+* @return true If a path to the food was found and `next_move` was set.
+* @return false If the food is unreachable.
+*/
+bool Snake::backtracking_search(Level& level, cell_t start, cell_t& next_move, size_t budget,
+                                std::chrono::steady_clock::time_point deadline) {
+    constexpr size_t clock_period = 256; // moves between two reads of the clock
+    constexpr size_t table_bits = 16;
+    constexpr size_t table_mask = (size_t{1} << table_bits) - 1;
+
+    found_foods = false;
+
+    const size_t n_tiles = level.tile_count();
+    const size_t stride = level.stride();
+    const auto& offsets = level.neighbor_offsets(); // up, right, down, left
+    const size_t food = level.food_cell();
+    const size_t food_row = food / stride;
+    const size_t food_col = food % stride;
+
+    auto manhattan = [&](size_t idx) -> size_t {
+        size_t row = idx / stride;
+        size_t col = idx % stride;
+        return (row > food_row ? row - food_row : food_row - row) + (col > food_col ? col - food_col : food_col - col);
+    };
+
+    if (zobrist.size() != 2 * n_tiles) {
+        std::mt19937_64 keys{n_tiles}; // fixed seed: runs stay reproducible
+        zobrist.resize(2 * n_tiles);
+        for (std::uint64_t& key : zobrist) key = keys();
+    }
+    if (transpositions.empty()) transpositions.resize(table_mask + 1);
+    if (++tt_epoch == 0) { // wrapped around: stale entries would look current
+        std::fill(transpositions.begin(), transpositions.end(), TranspositionEntry{});
+        tt_epoch = 1;
+    }
+
+    virtual_tiles.assign(level.tiles(), level.tiles() + n_tiles);
 
-            if(V.row<level.n_rows() and V.col<level.n_cols() and not visit[V.row][V.col] and not level.crashed(V)){// Check if it is within bounds, unvisited and collision-free
-                visit[V.row][V.col]=true;
-                fila.push(V);
+    // The virtual body at depth d is bt_body[d .. d + length - 1], tail first.
+    const size_t length = body.size();
+    bt_body.clear();
+    std::uint64_t hash = 0;
+    for (size_t i = length; i > 0; --i) {
+        size_t idx = body.cell(i - 1);
+        bt_body.push_back(static_cast<std::uint32_t>(idx));
+        hash ^= zobrist[idx];
+    }
+    hash ^= zobrist[n_tiles + bt_body.back()];
+
+    bt_moves.clear();
+    bt_tried.clear();
+    bt_count.clear();
 
-                main[V.row*level.n_cols()+V.col]=curr;
+    // Pushes the free neighbors of the virtual head, closest to the food first.
+    auto expand = [&]() {
+        size_t head = bt_body.back();
+        std::uint32_t moves[4];
+        size_t dist[4];
+        int n = 0;
 
-                if (level.crashed(V)) {
-                    sin.input_colision(false, collision);
-                    return;
+        for (long offset : offsets) {
+            size_t V = head + offset;
+            if (virtual_tiles[V] == Level::EMPTY or virtual_tiles[V] == Level::FOOD) {
+                moves[n] = static_cast<std::uint32_t>(V);
+                dist[n] = manhattan(V);
+                for (int j = n; j > 0 and dist[j] < dist[j - 1]; --j) {
+                    std::swap(dist[j], dist[j - 1]);
+                    std::swap(moves[j], moves[j - 1]);
                 }
+                ++n;
+            }
+        }
+
+        for (int i = 0; i < 4; ++i) bt_moves.push_back(i < n ? moves[i] : 0);
+        bt_count.push_back(static_cast<std::uint8_t>(n));
+        bt_tried.push_back(0);
+    };
+
+    size_t best_length = n_tiles; // no path is that long
+    size_t nodes = 0;
+    expand();
+
+    while (not bt_count.empty() and nodes < budget) {
+        size_t depth = bt_count.size() - 1;
+
+        if (bt_tried[depth] == bt_count[depth]) {
+            // Dead end: take the last move back
+            bt_moves.resize(bt_moves.size() - 4);
+            bt_count.pop_back();
+            bt_tried.pop_back();
+            if (depth == 0) break;
+
+            size_t head = bt_body.back();
+            size_t tail = bt_body[depth - 1];
+            bt_body.pop_back();
+            virtual_tiles[head] = Level::EMPTY;
+            virtual_tiles[tail] = Level::SNAKE_BODY;
+            hash ^= zobrist[head] ^ zobrist[n_tiles + head] ^ zobrist[tail] ^ zobrist[n_tiles + bt_body.back()];
+            continue;
+        }
+
+        if (nodes % clock_period == clock_period - 1 and std::chrono::steady_clock::now() >= deadline) break;
+
+        size_t V = bt_moves[depth * 4 + bt_tried[depth]++];
+        size_t moves = depth + 1;
+        ++nodes;
+
+        if (V == food) {
+            if (moves < best_length) {
+                best_length = moves;
+                path.assign(bt_body.begin() + length, bt_body.end());
+                path.push_back(static_cast<std::uint32_t>(V));
             }
+            continue;
         }
+
+        if (moves + manhattan(V) >= best_length) {
+            ++nodes_pruned;
+            continue;
+        }
+
+        // Move the virtual snake: the head enters V, then the tail leaves its tile.
+        size_t old_head = bt_body.back();
+        size_t tail = bt_body[depth];
+        hash ^= zobrist[n_tiles + old_head] ^ zobrist[V] ^ zobrist[n_tiles + V] ^ zobrist[tail];
+
+        ++cache_probes;
+        TranspositionEntry& entry = transpositions[hash & table_mask];
+        if (entry.epoch == tt_epoch and entry.key == hash and entry.depth <= moves) {
+            ++cache_hits;
+            hash ^= zobrist[n_tiles + old_head] ^ zobrist[V] ^ zobrist[n_tiles + V] ^ zobrist[tail];
+            continue;
+        }
+        entry = TranspositionEntry{hash, static_cast<std::uint32_t>(moves), tt_epoch};
+
+        bt_body.push_back(static_cast<std::uint32_t>(V));
+        virtual_tiles[V] = Level::SNAKE_HEAD;
+        virtual_tiles[tail] = Level::EMPTY;
+        expand();
     }
-    if(fila.empty()){   /// If it didn't find a path, change it to random.
-        sin.troca();
+    nodes_expanded += nodes;
+
+    if (best_length == n_tiles) {
+        clear_path();
+        return breadthFirst_search(level, start, next_move);
     }
+
+    found_foods = true;
+    path_pos = 1;
+    path_food = static_cast<std::uint32_t>(food);
+    next_move = static_cast<cell_t>(path.front());
+    return true;
+}
+
+/**
+* @brief Breadth-first search on row bitsets (see `BitboardBfs`).
+* 
+* Finds the same path lengths as `breadthFirst_search`, but expands a whole
+* frontier with a few word operations per row. Only the first move is known, so
+* nothing is cached: the next decision searches again.
+* 
+* @param level Reference to the current game level, containing the maze.
+* @param start Current position of the snake's head.
+* @param next_move Reference to where the next calculated move will be stored.
+* 
+* @return true If a path to the food was found and `next_move` was set.
+* @return false If the food is unreachable.
+*/
+bool Snake::bitboard_search(Level& level, cell_t start, cell_t& next_move) {
+    found_foods = false;
+    clear_path();
+
+    size_t first_move;
+    std::size_t reached;
+    size_t length = bitboard.search(level, start, first_move, reached);
+    nodes_expanded += reached;
+
+    if (length == 0) return false;
+
+    found_foods = true;
+    next_move = static_cast<cell_t>(first_move);
+    return true;
+}
+
+/**
+* @brief Performs an A* search to find the shortest path to the food.
+* 
+* Same contract as `breadthFirst_search`, but tiles are expanded in order of
+* path cost plus Manhattan distance to the food (an admissible and consistent
+* heuristic on a 4-connected grid), breaking ties toward the food. Only the region
+* between the head and the food gets explored, instead of every tile closer than it.
+* 
+* @param level Reference to the current game level, containing the maze.
+* @param start Current position of the snake's head.
+* @param next_move Reference to where the next calculated move will be stored.
+* 
+* @return true If a path to the food was found and `next_move` was set.
+* @return false If the food is unreachable.
+* 
+* @note The open list is a binary heap with lazy deletion: outdated entries are
+* skipped when popped. Heap and scratch buffers are reused, so no allocation happens
+* in steady state.
+*/
+bool Snake::astar_search(Level& level, cell_t start, cell_t& next_move) {
+    const auto& offsets = level.neighbor_offsets(); // up, right, down, left
+    const TilePos food = level.get_food_loc();
+    const size_t food_idx = level.food_cell();
+
+    auto manhattan = [&](size_t idx) {
+        TilePos pos = level.position(idx);
+        size_t dr = pos.row > food.row ? pos.row - food.row : food.row - pos.row;
+        size_t dc = pos.col > food.col ? pos.col - food.col : food.col - pos.col;
+        return static_cast<std::uint32_t>(dr + dc);
+    };
+
+    found_foods = false;
+    collision = false;
+
+    size_t start_idx = start;
+    scratch.prepare(level.tile_count());
+    scratch.visit(start_idx);
+    scratch.cost[start_idx] = 0;
+
+    open_heap.clear();
+    std::uint32_t h_start = manhattan(start_idx);
+    open_heap.push_back(OpenNode{h_start, h_start, static_cast<std::uint32_t>(start_idx)});
+
+    while (not open_heap.empty()) {
+        std::pop_heap(open_heap.begin(), open_heap.end());
+        OpenNode node = open_heap.back();
+        open_heap.pop_back();
+
+        size_t curr = node.idx;
+        std::uint32_t g = node.f - node.h;
+        if (g != scratch.cost[curr]) continue; // outdated entry
+
+        ++nodes_expanded;
+
+        if (curr == food_idx) {
+            found_foods = true;
+            break;
+        }
+
+        for (long offset : offsets) {
+            size_t V = curr + offset;
+
+            if (not level.walkable(V)) continue;
+            if (scratch.visited(V) and scratch.cost[V] <= g + 1) continue;
+
+            scratch.visit(V);
+            scratch.cost[V] = g + 1;
+            scratch.pred[V] = static_cast<std::uint32_t>(curr);
+
+            std::uint32_t h = manhattan(V);
+            open_heap.push_back(OpenNode{g + 1 + h, h, static_cast<std::uint32_t>(V)});
+            std::push_heap(open_heap.begin(), open_heap.end());
+        }
+    }
+
     if (found_foods) {
-        found_food(next_move, found_foods, food_pos, main, level, start);
-        if (next_move == level.get_food_loc()) {
-            SnazeSimulation& sin = SnazeSimulation::getInstance();
-            sin.input_colision(true, collision); // found food
-        }   
+        found_food(next_move, food_idx, start_idx, level);
     }
-} 
+    return found_foods;
+}
+
+/**
+* @brief Performs a bidirectional breadth-first search between the head and the food.
+* 
+* Same contract as `breadthFirst_search`. One frontier grows from the head (`scratch`)
+* and another from the food (`scratch_back`); each round, the smaller frontier is
+* expanded by one full layer. The search stops at the end of the first layer in
+* which the frontiers touch, keeping the shortest of the connections found in it,
+* so the path has the same length as the one-sided BFS while exploring roughly two
+* small balls instead of one large one.
+* 
+* @param level Reference to the current game level, containing the maze.
+* @param start Current position of the snake's head.
+* @param next_move Reference to where the next calculated move will be stored.
+* 
+* @return true If a path to the food was found and `next_move` was set.
+* @return false If the food is unreachable.
+* 
+* @note In `scratch_back`, `pred` points one step closer to the food.
+*/
+bool Snake::bidirectional_search(Level& level, cell_t start, cell_t& next_move) {
+    const auto& offsets = level.neighbor_offsets(); // up, right, down, left
+    const std::uint32_t NONE = UINT32_MAX;
+
+    found_foods = false;
+    collision = false;
+
+    size_t start_idx = start;
+    size_t food_idx = level.food_cell();
+    if (level.tiles()[food_idx] != Level::FOOD) return false;
+
+    scratch.prepare(level.tile_count());
+    scratch_back.prepare(level.tile_count());
+    scratch.visit(start_idx);
+    scratch.cost[start_idx] = 0;
+    scratch.push(start_idx);
+    scratch_back.visit(food_idx);
+    scratch_back.cost[food_idx] = 0;
+    scratch_back.push(food_idx);
+
+    std::uint32_t best = NONE;        // Length of the best connection found
+    size_t meet_front = 0;            // Its last tile on the head side
+    size_t meet_back = 0;             // Its first tile on the food side
+
+    while (best == NONE and not scratch.empty() and not scratch_back.empty()) {
+        bool forward = scratch.count <= scratch_back.count;
+        SearchScratch& side = forward ? scratch : scratch_back;
+        SearchScratch& other = forward ? scratch_back : scratch;
+
+        for (size_t layer = side.count; layer > 0; --layer) {
+            size_t curr = side.pop();
+            ++nodes_expanded;
+
+            for (long offset : offsets) {
+                size_t V = curr + offset;
+
+                if (other.visited(V)) { // The frontiers touch
+                    std::uint32_t length = side.cost[curr] + 1 + other.cost[V];
+                    if (length < best) {
+                        best = length;
+                        meet_front = forward ? curr : V;
+                        meet_back = forward ? V : curr;
+                    }
+                } else if (not side.visited(V) and level.walkable(V)) {
+                    side.visit(V);
+                    side.cost[V] = side.cost[curr] + 1;
+                    side.pred[V] = static_cast<std::uint32_t>(curr);
+                    side.push(V);
+                }
+            }
+        }
+    }
+
+    if (best == NONE) return false;
+
+    // Head side, walked backwards from the meeting point, then food side in order.
+    path.clear();
+    for (size_t curr = meet_front; curr != start_idx; curr = scratch.pred[curr]) {
+        path.push_back(static_cast<std::uint32_t>(curr));
+    }
+    std::reverse(path.begin(), path.end());
+    for (size_t curr = meet_back; curr != food_idx; curr = scratch_back.pred[curr]) {
+        path.push_back(static_cast<std::uint32_t>(curr));
+    }
+    path.push_back(static_cast<std::uint32_t>(food_idx));
+    path_pos = 1;
+    path_food = static_cast<std::uint32_t>(food_idx);
+
+    found_foods = true;
+    next_move = static_cast<cell_t>(path.front());
+    return true;
+}
+
+/**
+* @brief Rebuilds the distance field towards the current food.
+* 
+* One reverse breadth-first search from the food gives, for every tile, the length
+* of its shortest path to the food. Walls are obstacles but the snake is not, since
+* it moves every tick: the field stays valid until the food moves.
+* 
+* @param level Reference to the current game level, containing the maze.
+*/
+void Snake::build_food_field(const Level& level) {
+    const std::uint8_t* tiles = level.tiles();
+    const auto& offsets = level.neighbor_offsets(); // up, right, down, left
+    size_t food_idx = level.food_cell();
+
+    food_field.assign(level.tile_count(), UNREACHABLE);
+    field_serial = level.food_serial();
+
+    if (tiles[food_idx] != Level::FOOD) return;
+
+    scratch.prepare(level.tile_count());
+    food_field[food_idx] = 0;
+    scratch.push(food_idx);
+
+    while (not scratch.empty()) {
+        size_t curr = scratch.pop();
+        ++nodes_expanded;
+
+        for (long offset : offsets) {
+            size_t V = curr + offset;
+
+            if (food_field[V] == UNREACHABLE and tiles[V] != Level::WALL and tiles[V] != Level::INV_WALL) {
+                food_field[V] = food_field[curr] + 1;
+                scratch.push(V);
+            }
+        }
+    }
+}
+
+/**
+* @brief Follows the distance field of the food one step.
+* 
+* The field is rebuilt only when the food has moved (`Level::food_serial()`), so
+* most decisions just look at the head's four neighbors and step to a free one that
+* is one tile closer to the food. When the snake's body blocks every such neighbor,
+* a local repair runs: a breadth-first search from the head that stops at the first
+* free tile closer to the food than the head, whose path is then followed through
+* the path cache.
+* 
+* @param level Reference to the current game level, containing the maze.
+* @param start Current position of the snake's head.
+* @param next_move Reference to where the next calculated move will be stored.
+* 
+* @return true If a move towards the food was found and `next_move` was set.
+* @return false If the food cannot be reached from the head.
+*/
+bool Snake::field_search(Level& level, cell_t start, cell_t& next_move) {
+    const auto& offsets = level.neighbor_offsets(); // up, right, down, left
+
+    found_foods = false;
+    collision = false;
+
+    if (field_serial != level.food_serial() or food_field.size() != level.tile_count()) {
+        build_food_field(level);
+    }
+
+    size_t start_idx = start;
+    std::uint32_t here = food_field[start_idx];
+    if (here == UNREACHABLE) return false;
+
+    // Gradient step
+    for (long offset : offsets) {
+        size_t V = start_idx + offset;
+        ++nodes_expanded;
+
+        if (food_field[V] < here and level.walkable(V)) {
+            found_foods = true;
+            next_move = static_cast<cell_t>(V);
+            return true;
+        }
+    }
+
+    // Local repair: the body blocks the gradient.
+    scratch.prepare(level.tile_count());
+    scratch.visit(start_idx);
+    scratch.push(start_idx);
+
+    while (not scratch.empty()) {
+        size_t curr = scratch.pop();
+        ++nodes_expanded;
+
+        if (food_field[curr] < here) {
+            found_foods = true;
+            found_food(next_move, curr, start_idx, level);
+            return true;
+        }
+
+        for (long offset : offsets) {
+            size_t V = curr + offset;
+
+            if (not scratch.visited(V) and level.walkable(V)) {
+                scratch.visit(V);
+                scratch.pred[V] = static_cast<std::uint32_t>(curr);
+                scratch.push(V);
+            }
+        }
+    }
+
+    return false;
+}
+
+/**
+* @brief Finds a free tile adjacent to a target, reachable from a start tile.
+* 
+* Breadth-first search over the tiles accepted by `free`, that stops at the first
+* tile (other than `start_idx`) next to `target_idx`. Used to check that the head
+* can follow the tail, which frees its tile one step ahead of the head.
+* 
+* @param tiles The tile array to search (the level's, or a virtual copy).
+* @param stride Distance between two rows of `tiles`.
+* @param start_idx Index of the tile the search starts from.
+* @param target_idx Index of the tile to get next to.
+* @param found Receives the index of the tile found.
+* 
+* @return true If such a tile exists; `scratch.pred` then leads back to `start_idx`.
+* @return false Otherwise.
+*/
+bool Snake::reach_next_to(const std::uint8_t* tiles, size_t stride, size_t start_idx, size_t target_idx, size_t& found) {
+    const long offsets[4] = {-static_cast<long>(stride), 1, static_cast<long>(stride), -1}; // up, right, down, left
+
+    scratch.visit(start_idx);
+    scratch.push(start_idx);
+
+    while (not scratch.empty()) {
+        size_t curr = scratch.pop();
+        ++nodes_expanded;
+
+        size_t gap = curr > target_idx ? curr - target_idx : target_idx - curr;
+        if (curr != start_idx and (gap == 1 or gap == stride)) {
+            found = curr;
+            return true;
+        }
+
+        for (long offset : offsets) {
+            size_t V = curr + offset;
+
+            if (not scratch.visited(V) and (tiles[V] == Level::EMPTY or tiles[V] == Level::FOOD)) {
+                scratch.visit(V);
+                scratch.pred[V] = static_cast<std::uint32_t>(curr);
+                scratch.push(V);
+            }
+        }
+    }
+
+    return false;
+}
+
+/**
+* @brief Checks that the snake could still reach its tail after eating along `path`.
+* 
+* The snake is moved along the cached path on a virtual copy of the grid: the tiles
+* of the current body are freed, and the body after the meal (the path walked
+* backwards, then the front of the current body, one segment longer than now) is
+* drawn instead. A second search then looks for a way from the virtual head to the
+* virtual tail.
+* 
+* @param level Reference to the current game level, containing the maze.
+* @return true If the head can follow its tail after the meal.
+* 
+* @note The virtual grid is a reused buffer, so the check performs no allocation.
+*/
+bool Snake::path_is_safe(const Level& level) {
+    virtual_tiles.assign(level.tiles(), level.tiles() + level.tile_count());
+
+    for (size_t i = 0; i < body.size(); ++i) {
+        virtual_tiles[body.cell(i)] = Level::EMPTY;
+    }
+
+    size_t new_length = body.size() + 1;
+    size_t drawn = 0;
+    size_t tail = 0;
+
+    for (size_t k = path.size(); k > 0 and drawn < new_length; --k, ++drawn) {
+        tail = path[k - 1];
+        virtual_tiles[tail] = Level::SNAKE_BODY;
+    }
+    for (size_t i = 0; i < body.size() and drawn < new_length; ++i, ++drawn) {
+        tail = body.cell(i);
+        virtual_tiles[tail] = Level::SNAKE_BODY;
+    }
+
+    size_t head = path.back();
+    virtual_tiles[head] = Level::SNAKE_HEAD;
+
+    size_t found;
+    scratch.prepare(level.tile_count());
+    return reach_next_to(virtual_tiles.data(), level.stride(), head, tail, found);
+}
+
+/**
+* @brief Survival-aware search: eats only when the snake can still follow its tail afterwards.
+* 
+* The shortest path to the food (`breadthFirst_search`) is kept only if `path_is_safe`
+* accepts it. Otherwise the snake chases its tail, one step towards the nearest free
+* tile next to it, and plans again on the next decision. If the path is still unsafe
+* after more tail-chasing steps than there are free tiles, it is taken anyway, so
+* that the game always moves on.
+* 
+* @param level Reference to the current game level, containing the maze.
+* @param start Current position of the snake's head.
+* @param next_move Reference to where the next calculated move will be stored.
+* 
+* @return true If a safe path to the food, or a tail-chasing move, was found.
+* @return false If neither exists.
+*/
+bool Snake::survival_search(Level& level, cell_t start, cell_t& next_move) {
+    if (breadthFirst_search(level, start, next_move)) {
+        // Once the snake has chased its tail around the whole free area without the
+        // path becoming safe, waiting longer will not help: take the risk.
+        if (path_is_safe(level) or chase_steps > level.n_free_tiles() + body.size()) {
+            chase_steps = 0;
+            return true;
+        }
+    }
+
+    return chase_tail(level, start, next_move);
+}
+
+/**
+* @brief Takes one step towards the nearest free tile next to the tail.
+* 
+* Used when eating now would trap the snake: following the tail keeps it alive
+* while the body moves out of the way. The path is not cached, since the tail
+* moves too: the next decision searches again.
+* 
+* @param level Reference to the current game level, containing the maze.
+* @param start Current position of the snake's head.
+* @param next_move Reference to where the next calculated move will be stored.
+* 
+* @return true If a tile next to the tail is reachable and `next_move` was set.
+* @return false If the snake has no tail or it cannot be reached.
+*/
+bool Snake::chase_tail(Level& level, cell_t start, cell_t& next_move) {
+    clear_path();
+    found_foods = false;
+    if (body.size() < 2) return false;
+    ++chase_steps;
+
+    size_t start_idx = start;
+    size_t found;
+    scratch.prepare(level.tile_count());
+    if (not reach_next_to(level.tiles(), level.stride(), start_idx, body.cell(body.size() - 1), found)) {
+        return false;
+    }
+
+    found_food(next_move, found, start_idx, level);
+    clear_path(); // The tail moves: decide again next time.
+    return true;
+}
+
+/**
+* @brief Anytime planner: refines its move until the deadline.
+* 
+* The branch and bound search runs without a node budget and keeps shortening its
+* best path until it has proven it optimal or the deadline has passed. With the time
+* left, the path is checked the way the survival player does it, and the snake
+* chases its tail instead if eating would trap it.
+* 
+* @param level Reference to the current game level, containing the maze.
+* @param start Current position of the snake's head.
+* @param next_move Reference to where the next calculated move will be stored.
+* @param deadline Moment the move must be decided by.
+* 
+* @return true If a move towards the food, or a tail-chasing move, was found.
+* @return false If neither exists.
+*/
+bool Snake::anytime_search(Level& level, cell_t start, cell_t& next_move,
+                           std::chrono::steady_clock::time_point deadline) {
+    // Keep a tenth of the time for the safety check.
+    auto now = std::chrono::steady_clock::now();
+    auto search_deadline = deadline > now ? deadline - (deadline - now) / 10 : now;
+
+    if (not backtracking_search(level, start, next_move, SIZE_MAX, search_deadline)) {
+        return chase_tail(level, start, next_move);
+    }
+
+    if (std::chrono::steady_clock::now() >= deadline or path_is_safe(level)
+        or chase_steps > level.n_free_tiles() + body.size()) {
+        chase_steps = 0;
+        return true;
+    }
+
+    cell_t shortest_move = next_move;
+    if (chase_tail(level, start, next_move)) return true;
+
+    next_move = shortest_move;
+    found_foods = true;
+    return true;
+}
+
+/**
+* @brief Monte Carlo player: tries every legal move with many random continuations.
+* 
+* Each free neighbor of the head is scored by the mean of `rollouts` games played
+* from it (see `rollout()`): walking mostly towards the food, then at random once
+* it is eaten. A move that leads the snake into a dead end scores low even if it is
+* on a shortest path, so among equally short routes the roomiest one is chosen.
+* 
+* Every rollout starts from a copy of one flat snapshot of the grid and body, held
+* per thread, and has its own generator seeded from the snake's one: the result
+* does not depend on how the rollouts are spread over the threads of `pool`.
+* 
+* @param level Reference to the current game level, containing the maze.
+* @param start Current position of the snake's head.
+* @param next_move Reference to where the next calculated move will be stored.
+* @param pool The threads that play the rollouts.
+* @param rollouts Number of rollouts per legal move.
+* 
+* @return true If the head has a free neighbor; `next_move` is the best one.
+* @return false If the snake is trapped.
+*/
+bool Snake::montecarlo_search(Level& level, cell_t start, cell_t& next_move, WorkStealingPool& pool, size_t rollouts) {
+    constexpr size_t grain = 4; // rollouts played in a row by one thread
+    const auto& offsets = level.neighbor_offsets(); // up, right, down, left
+
+    found_foods = false;
+    clear_path();
+
+    if (field_serial != level.food_serial() or food_field.size() != level.tile_count()) {
+        build_food_field(level);
+    }
+
+    size_t head = start;
+    size_t moves[4];
+    size_t n_moves = 0;
+    for (long offset : offsets) {
+        size_t V = head + offset;
+        if (level.walkable(V)) moves[n_moves++] = V;
+    }
+    if (n_moves == 0) return false;
+    rollouts = std::max<size_t>(rollouts, 1);
+
+    // Snapshot shared by every rollout
+    mc_root.tiles.assign(level.tiles(), level.tiles() + level.tile_count());
+    mc_root.body.clear();
+    for (size_t i = body.size(); i > 0; --i) {
+        mc_root.body.push_back(static_cast<std::uint32_t>(body.cell(i - 1)));
+    }
+    mc_root.tail = 0;
+
+    size_t food = level.food_cell();
+    size_t to_food = food_field[head] == UNREACHABLE ? 0 : food_field[head];
+    RolloutSetup setup{&food_field, level.stride(), food, to_food + body.size() + 32};
+
+    mc_scores.assign(n_moves * rollouts, 0.0);
+    mc_steps.assign(n_moves * rollouts, 0);
+    std::uint64_t base_seed = (static_cast<std::uint64_t>(rng()) << 32) | rng();
+
+    pool.parallel_for(n_moves * rollouts, [&](size_t i) {
+        thread_local RolloutState state;
+        state.copy_from(mc_root);
+        mc_scores[i] = rollout(state, setup, moves[i / rollouts], base_seed + i * 0x9E3779B97F4A7C15ull, mc_steps[i]);
+    }, grain);
+
+    // Best mean score; ties go to the move closer to the food.
+    size_t best = 0;
+    double best_score = -1.0;
+    for (size_t m = 0; m < n_moves; ++m) {
+        double score = 0.0;
+        for (size_t r = 0; r < rollouts; ++r) {
+            score += mc_scores[m * rollouts + r];
+            nodes_expanded += mc_steps[m * rollouts + r];
+        }
+        score /= rollouts;
+
+        if (score > best_score or (score == best_score and food_field[moves[m]] < food_field[moves[best]])) {
+            best = m;
+            best_score = score;
+        }
+    }
+
+    found_foods = (moves[best] == food);
+    next_move = static_cast<cell_t>(moves[best]);
+    return true;
+}
+
+/**
+* @brief Hamiltonian-cycle player: follows the cycle, cutting corners while it is safe.
+* 
+* Along the cycle, the tail always lies ahead of the head and every tile in between
+* is free, so the next tile of the cycle is always safe. While the snake is shorter
+* than half the cycle, the head may instead jump to any free neighbor further along
+* the cycle, as long as it neither overshoots the food nor gets close to the tail.
+* The decision only looks at the four neighbors of the head: O(1) per move.
+* 
+* @param level Reference to the current game level, containing the maze.
+* @param start Current position of the snake's head.
+* @param next_move Reference to where the next calculated move will be stored.
+* @param cycle The Hamiltonian cycle of `level`.
+* 
+* @return true If a move was found.
+* @return false If the head is off the cycle or the next tile of the cycle is taken.
+*/
+bool Snake::hamiltonian_search(Level& level, cell_t start, cell_t& next_move, const HamiltonianCycle& cycle) {
+    constexpr size_t margin = 3; // free tiles kept between the head and the tail after a shortcut
+
+    clear_path();
+    found_foods = false;
+
+    size_t head = start;
+    if (not cycle.contains(head)) return false;
+
+    const size_t n_cells = cycle.size();
+    const auto& offsets = level.neighbor_offsets(); // up, right, down, left
+
+    size_t food = level.food_cell();
+    size_t to_food = cycle.contains(food) ? cycle.distance(head, food) : n_cells;
+    size_t to_tail = body.size() > 1 ? cycle.distance(head, body.cell(body.size() - 1)) : n_cells;
+
+    size_t best = cycle.next(head);
+    size_t best_dist = 1;
+
+    if (body.size() < n_cells / 2) {
+        for (long offset : offsets) {
+            size_t V = head + offset;
+            if (not cycle.contains(V) or not level.walkable(V)) continue;
+
+            size_t d = cycle.distance(head, V);
+            if (d > best_dist and d <= to_food and d + margin < to_tail) {
+                best = V;
+                best_dist = d;
+            }
+        }
+    }
+    nodes_expanded += 4;
+
+    if (not level.walkable(best)) return false;
+
+    found_foods = (best == food);
+    next_move = static_cast<cell_t>(best);
+    return true;
+}
 
 /**
 * @brief Sets the snake's next direction based on a random search.
@@ -287,20 +1138,21 @@ void SnazeSimulation::snake_update(){
         snake_obj.body.push_front(next_pos);
 
         if(not comeu){
-            TilePos tail = snake_obj.body.back();
+            cell_t tail = snake_obj.body.cell(snake_obj.body.size() - 1);
             snake_obj.body.pop_back();
-            levels[current_level_index].set_tile_type(Level::tile_type_e::EMPTY, tail);
+            levels[current_level_index].set_tile(Level::tile_type_e::EMPTY, tail);
 
         }else {
-            levels[current_level_index].place_food();
+            levels[current_level_index].place_food(rng);
         }
 
         if (snake_obj.body.size() > 1) {
-            levels[current_level_index].set_tile_type(Level::tile_type_e::SNAKE_BODY, snake_obj.body[1]);
+            levels[current_level_index].set_tile(Level::tile_type_e::SNAKE_BODY, snake_obj.body.cell(1));
         }
 
     head_pos = next_pos;
     dir = next_dir;
+    ++n_steps;
 }
 
 /**
@@ -311,16 +1163,27 @@ void SnazeSimulation::snake_update(){
 * retrieval states, and marks the new head position in the maze.
 * 
 * @param level Reference to the Level object containing the current maze.
+* @param food_rng The simulation's generator, to draw a new food tile with.
 * 
 * @note This function assumes that the level is already loaded correctly
 * and that the spawn position returned by level.get_spawn_loc() is valid.
+* If the food lies on the spawn position, it is moved somewhere else.
 */
-void Snake::reset(Level& level){
+void Snake::reset(Level& level, std::mt19937& food_rng){
 
-    body.clear();    // Remove all body segments from the previous snake
+    body.reset(level.n_open_tiles(), level.stride()); // Remove all body segments from the previous snake
+    clear_path();    // The cached path belongs to the previous life or level
+    field_serial = 0; // So does the distance field
+    chase_steps = 0;
     TilePos start_pos = level.get_spawn_loc();
+    bool food_on_spawn = (level.get_tile_type(start_pos) == Level::FOOD);
     body.push_back(start_pos);
     level.set_tile_type(Level::SNAKE_HEAD, start_pos);
+
+    // The head would hide the food forever, so it gets a new place.
+    if (food_on_spawn) {
+        level.place_food(food_rng);
+    }
    
     // Resets food found and collision states
     found_foods = false;
@@ -1,11 +1,17 @@
 #ifndef SNAKE_HPP
 #define SNAKE_HPP
 
+#include "bitboard.hpp"
+#include "montecarlo.hpp"
+#include "search_scratch.hpp"
+#include "snake_body.hpp"
 #include "tile_pos.hpp"
 
-#include <deque>
+#include <chrono>
+#include <cstdint>
 #include <optional>
-#include <unordered_map>
+#include <random>
+#include <vector>
 
 // Forward declaration for the Level class. This informs the compiler that 'Level' is a class.
 /**
@@ -14,6 +20,8 @@
  * Allows referencing the `Level` class before its full definition.
  */
 class Level;
+class HamiltonianCycle;
+class WorkStealingPool;
 
 /**
  * @brief Enumeration representing the four orthogonal directions.
@@ -37,34 +45,114 @@ enum class direction {
 TilePos move(TilePos current_pos, direction dir);
 
 
+/**
+ * @brief Entry of the A* open list.
+ *
+ * Ordered by total estimated cost `f`, then by remaining estimate `h`, so that among
+ * equally good tiles the one closest to the goal is expanded first.
+ */
+struct OpenNode {
+    std::uint32_t f;    ///< Path cost so far plus Manhattan distance to the food
+    std::uint32_t h;    ///< Manhattan distance to the food
+    std::uint32_t idx;  ///< Tile index (see `Level::index()`)
+
+    /// @brief Heap comparison: true if `other` should be expanded before this node.
+    bool operator<(const OpenNode& other) const {
+        return f != other.f ? f > other.f : h > other.h;
+    }
+};
+
+/**
+ * @brief Entry of the transposition table of the backtracking search.
+ *
+ * Records the smallest depth at which a snake state (see `Snake::backtracking_search`)
+ * was reached by the current search; reaching it again no earlier is a dead branch.
+ */
+struct TranspositionEntry {
+    std::uint64_t key = 0;      ///< Zobrist hash of the state
+    std::uint32_t depth = 0;    ///< Number of moves from the root to the state
+    std::uint32_t epoch = 0;    ///< Search that wrote the entry; older entries are stale
+};
+
 /**
  * @brief Class representing the snake in the game.
  */
 class Snake {
 public:
-    std::deque<TilePos> body;            ///< Snake body represented as sequential positions
+    SnakeBody body;                      ///< Snake body, from head to tail
 
 public:
     bool found_foods = false;            ///< Flag indicating if the snake found food
     bool collision = false;              ///< Flag indicating a collision occurred
     bool wall_collision = false;         ///< Flag indicating a collision with a wall
+    std::size_t nodes_expanded = 0;      ///< Total number of tiles expanded by the searches
+    std::size_t nodes_pruned = 0;        ///< Total number of moves cut by the backtracking search's lower bound
+    std::size_t cache_probes = 0;        ///< Total number of transposition table lookups
+    std::size_t cache_hits = 0;          ///< Lookups that found the state already reached no deeper
+
+private:
+    std::mt19937 rng;                         ///< Generator of the random search and the rollouts, seeded by the simulation
+    SearchScratch scratch;                    ///< Working memory reused by every search
+    SearchScratch scratch_back;               ///< Working memory of the food-side half of the bidirectional search
+    std::vector<std::uint32_t> path;          ///< Tiles (see `Level::index()`) of the last path found, from the first move to the food
+    std::vector<OpenNode> open_heap;          ///< Binary min-heap of the A* open list, reused between searches
+    size_t path_pos = 0;                      ///< Next tile of `path` to move to
+    std::uint32_t path_food = 0;              ///< Tile of the food when `path` was planned
+    std::vector<std::uint32_t> food_field;    ///< Distance from every tile to the food, ignoring the snake
+    std::size_t field_serial = 0;             ///< `Level::food_serial()` of the food `food_field` leads to; 0 if none
+
+    std::vector<std::uint8_t> virtual_tiles;  ///< Copy of the grid on which the survival check moves a virtual snake
+    std::size_t chase_steps = 0;              ///< Consecutive tail-chasing moves of the survival search
+
+    std::vector<std::uint32_t> bt_body;       ///< Backtracking search: current body, tail first, followed by the moves of the branch
+    std::vector<std::uint32_t> bt_moves;      ///< Backtracking search: up to four ordered candidate moves per depth
+    std::vector<std::uint8_t> bt_tried;       ///< Backtracking search: number of candidates tried, per depth
+    std::vector<std::uint8_t> bt_count;       ///< Backtracking search: number of candidates, per depth
+    std::vector<std::uint64_t> zobrist;       ///< Random keys per tile: body keys, then head keys
+    std::vector<TranspositionEntry> transpositions; ///< Transposition table, indexed by the low bits of the hash
+    std::uint32_t tt_epoch = 0;               ///< Current search, to invalidate `transpositions` in O(1)
+
+    BitboardBfs bitboard;                     ///< Bitset search used by `bitboard_search`
+    RolloutState mc_root;                     ///< Monte Carlo search: snapshot of the game every rollout starts from
+    std::vector<double> mc_scores;            ///< Monte Carlo search: score of every rollout
+    std::vector<std::size_t> mc_steps;        ///< Monte Carlo search: number of moves of every rollout
+
+    static constexpr std::uint32_t UNREACHABLE = UINT32_MAX; ///< Distance of the tiles that cannot reach the food
 
 public:
     /// @Snake_actions
     ///@{
 
-    void init(TilePos start_pos);                                                       ///< Initializes the snake at the starting position
-    void breadthFirst_search(Level& level, TilePos start, TilePos& next_move);          ///< Breadth-first search to find path
+    void seed(std::uint32_t seed);                                                      ///< Reseeds the generator used by the random search
+    void init(const Level& level, TilePos start_pos);                                   ///< Initializes the snake at the starting position of a level
+    bool breadthFirst_search(Level& level, cell_t start, cell_t& next_move);            ///< Breadth-first search to find path; false if food is unreachable
+    bool backtracking_search(Level& level, cell_t start, cell_t& next_move, size_t budget,
+                             std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max()); ///< Depth-first branch and bound over snake states; false if food is unreachable
+    bool anytime_search(Level& level, cell_t start, cell_t& next_move, std::chrono::steady_clock::time_point deadline); ///< Branch and bound until the deadline, then a safety check with the time left
+    bool bitboard_search(Level& level, cell_t start, cell_t& next_move);                ///< Word-parallel BFS on row bitsets; false if food is unreachable
+    bool astar_search(Level& level, cell_t start, cell_t& next_move);                   ///< A* search with Manhattan heuristic; false if food is unreachable
+    bool bidirectional_search(Level& level, cell_t start, cell_t& next_move);           ///< BFS from the head and from the food at once; false if food is unreachable
+    bool field_search(Level& level, cell_t start, cell_t& next_move);                   ///< One step down the food's distance field; false if food is unreachable
+    void build_food_field(const Level& level);                                          ///< Reverse BFS from the food filling `food_field`
+    bool survival_search(Level& level, cell_t start, cell_t& next_move);                ///< Shortest path to food if the tail stays reachable after the meal, else tail chasing
+    bool hamiltonian_search(Level& level, cell_t start, cell_t& next_move, const HamiltonianCycle& cycle); ///< Next tile of the cycle, or a shortcut that does not pass the tail; false if the head is off the cycle
+    bool montecarlo_search(Level& level, cell_t start, cell_t& next_move, WorkStealingPool& pool, size_t rollouts); ///< Move with the best mean score over random rollouts, played in parallel
+    bool chase_tail(Level& level, cell_t start, cell_t& next_move);                     ///< One step towards the nearest free tile next to the tail
+    bool path_is_safe(const Level& level);                                              ///< Replays `path` on a virtual grid and checks the tail is still reachable
+    bool reach_next_to(const std::uint8_t* tiles, size_t stride, size_t start_idx, size_t target_idx, size_t& found); ///< BFS to the nearest free tile next to a target
     bool is_valid_position(const TilePos& pos, Level& level);                           ///< Checks if a position is valid to move to
     std::optional<direction> search_random(TilePos head_pos, Level& level);             ///< Searches for a valid random direction
-    void found_food(TilePos& next_move, bool& found, TilePos& food_pos, std::unordered_map<size_t, TilePos>& predecessor_map, Level& level, TilePos& start); ///< Finds path to food
+    void found_food(cell_t& next_move, size_t food_idx, size_t start_idx, const Level& level); ///< Walks the path back from the food, caches it and takes its first move
+    bool follow_path(const Level& level, cell_t head, cell_t& next_move);              ///< Takes the next move of the cached path; false if a new search is needed
+    void clear_path();                                                                 ///< Forgets the cached path
+    size_t path_length() const { return path.size(); }                                 ///< Number of moves of the last path found
 
     ///@}
 public:
     /// @Snake_in_Maze_actions
     ///@{
     
-    void reset(Level& level);  ///< Resets the snake in the current level
+    void reset(Level& level, std::mt19937& food_rng);  ///< Resets the snake in the current level; may move food off the spawn tile
     
     ///@}
 };
@@ -0,0 +1,122 @@
+#ifndef SNAKE_BODY_HPP
+#define SNAKE_BODY_HPP
+
+#include "tile_pos.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+/**
+ * @brief The tiles of the snake, from head to tail, in a fixed-capacity ring buffer.
+ *
+ * Segments are stored as 16-bit tile indices (see `Level::index()`; levels are at most
+ * 100x100, so every index fits) in one contiguous buffer, sized once per level to the
+ * number of tiles the snake could ever cover and rounded up to a power of two. Adding
+ * a head and dropping the tail are O(1) and never allocate; copying the body (e.g. to
+ * play a move ahead) is one small `memcpy`-like copy.
+ *
+ * Positions are converted from and to `TilePos` on the fly with the level's stride.
+ * `cell()` gives the raw index, for the planners that work on indices.
+ */
+class SnakeBody {
+public:
+    using slot_t = std::uint16_t; ///< Storage type of a segment (a tile index narrowed from `cell_t`).
+
+private:
+    std::vector<slot_t> m_cells;  ///< The ring buffer; its size is a power of two.
+    size_t m_mask = 0;            ///< `m_cells.size() - 1`
+    size_t m_front = 0;           ///< Slot of the head
+    size_t m_size = 0;            ///< Number of segments
+    size_t m_stride = 0;          ///< `Level::stride()` of the level the snake is in
+
+    /// @brief Converts a tile index to a position.
+    TilePos to_pos(size_t idx) const { return TilePos(idx / m_stride - 1, idx % m_stride - 1); }
+
+    /// @brief Converts a position to a tile index.
+    slot_t to_cell(TilePos pos) const { return static_cast<slot_t>((pos.row + 1) * m_stride + pos.col + 1); }
+
+public:
+    /// @brief Iterates over the positions of the segments, from head to tail.
+    class const_iterator {
+    private:
+        const SnakeBody* m_body;
+        size_t m_i;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = TilePos;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = TilePos;
+
+        const_iterator(const SnakeBody* body, size_t i) : m_body{body}, m_i{i} {}
+        TilePos operator*() const { return (*m_body)[m_i]; }
+        const_iterator& operator++() { ++m_i; return *this; }
+        bool operator==(const const_iterator& other) const { return m_i == other.m_i; }
+        bool operator!=(const const_iterator& other) const { return m_i != other.m_i; }
+    };
+
+    /**
+     * @brief Empties the body and sizes it for a level.
+     *
+     * @param capacity Maximum number of segments (the walkable tiles of the level).
+     * @param stride `Level::stride()` of the level.
+     */
+    void reset(size_t capacity, size_t stride) {
+        size_t slots = 1;
+        while (slots < capacity) slots *= 2;
+
+        if (m_cells.size() != slots) m_cells.assign(slots, 0);
+        m_mask = slots - 1;
+        m_front = 0;
+        m_size = 0;
+        m_stride = stride;
+    }
+
+    /// @brief Removes every segment, keeping the capacity.
+    void clear() { m_size = 0; }
+
+    /// @brief Gets the number of segments.
+    size_t size() const { return m_size; }
+
+    /// @brief Tells whether there is no segment.
+    bool empty() const { return m_size == 0; }
+
+    /// @brief Gets the maximum number of segments.
+    size_t capacity() const { return m_cells.size(); }
+
+    /// @brief Adds a segment in front of the head: the new head.
+    void push_front(TilePos pos) {
+        m_front = (m_front - 1) & m_mask;
+        m_cells[m_front] = to_cell(pos);
+        ++m_size;
+    }
+
+    /// @brief Adds a segment behind the tail: the new tail.
+    void push_back(TilePos pos) {
+        m_cells[(m_front + m_size) & m_mask] = to_cell(pos);
+        ++m_size;
+    }
+
+    /// @brief Removes the tail.
+    void pop_back() { --m_size; }
+
+    /// @brief Gets the tile index of a segment; 0 is the head.
+    size_t cell(size_t i) const { return m_cells[(m_front + i) & m_mask]; }
+
+    /// @brief Gets the position of a segment; 0 is the head.
+    TilePos operator[](size_t i) const { return to_pos(cell(i)); }
+
+    /// @brief Gets the position of the head.
+    TilePos front() const { return (*this)[0]; }
+
+    /// @brief Gets the position of the tail.
+    TilePos back() const { return (*this)[m_size - 1]; }
+
+    const_iterator begin() const { return const_iterator(this, 0); }      ///< Iterator to the head
+    const_iterator end() const { return const_iterator(this, m_size); }   ///< Iterator past the tail
+};
+
+#endif
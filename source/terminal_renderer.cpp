@@ -0,0 +1,71 @@
+#include "terminal_renderer.hpp"
+
+#include <cstring>
+
+/// @brief Screen row of the first row of the board: status line, separator and a blank line come first.
+static constexpr size_t BOARD_TOP = 4;
+
+/// @brief Appends the sequence moving the cursor to a screen cell.
+void TerminalRenderer::move_to(size_t row, size_t col) {
+    m_frame.append("\x1b[");
+    m_frame.append_number(static_cast<long>(row));
+    m_frame.append(';');
+    m_frame.append_number(static_cast<long>(col));
+    m_frame.append('H');
+}
+
+/// @brief Builds the frame showing a board, without writing it.
+std::string_view TerminalRenderer::compose(const BoardView& board, const StatusLine& status) {
+    const std::uint8_t* tiles = board.tiles;
+    const size_t stride = board.stride;
+
+    if (board.rows != m_rows or board.cols != m_cols) m_valid = false;
+    m_frame.clear();
+
+    if (not m_valid) {
+        // Full frame: clear the screen and draw everything from the top-left corner.
+        m_frame.append("\x1b[H\x1b[2J");
+        m_frame.append_status(status);
+        m_frame.append('\n');
+        m_frame.append(SEPARATOR);
+        m_frame.append("\n\n");
+        m_frame.append_board(board, GAME_GLYPHS);
+        m_frame.append('\n');
+        m_frame.append(SEPARATOR);
+        m_frame.append('\n');
+
+        m_rows = board.rows;
+        m_cols = board.cols;
+        m_status = status;
+        m_shown.assign(tiles, tiles + (m_rows + 2) * stride);
+        m_valid = true;
+    } else {
+        if (status != m_status) {
+            m_frame.append("\x1b[1;1H\x1b[2K");
+            m_frame.append_status(status);
+            m_status = status;
+        }
+
+        for (size_t row = 0; row < m_rows; ++row) {
+            const size_t first = (row + 1) * stride + 1;
+            if (std::memcmp(tiles + first, m_shown.data() + first, m_cols) == 0) continue;
+
+            // Drawing a glyph moves the cursor right, so a run of changed tiles needs one jump.
+            size_t cursor = m_cols;
+            for (size_t col = 0; col < m_cols; ++col) {
+                std::uint8_t tile = tiles[first + col];
+                if (tile == m_shown[first + col]) continue;
+
+                if (cursor != col) move_to(BOARD_TOP + row, col + 1);
+                m_frame.append_tile(GAME_GLYPHS, tile);
+                m_shown[first + col] = tile;
+                cursor = col + 1;
+            }
+        }
+
+        // Leave the cursor below the board, where the next full-screen message goes.
+        move_to(BOARD_TOP + m_rows + 2, 1);
+    }
+
+    return m_frame.view();
+}
@@ -0,0 +1,70 @@
+#ifndef TERMINAL_RENDERER_HPP
+#define TERMINAL_RENDERER_HPP
+
+#include "frame_composer.hpp"
+#include "level.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Draws the running game in place, redrawing only what changed since the last frame.
+ *
+ * The first frame clears the screen and draws the whole board. Every later frame is
+ * compared with the tiles presented last: only the tiles that differ (usually the head,
+ * the neck, the tail and the food) are drawn, each after an ANSI cursor-positioning
+ * sequence. The status line is redrawn only when its text changes. Each frame reaches
+ * the terminal through a single `write()`.
+ *
+ * Anything else printed to the terminal scrolls the board away, so whoever prints it
+ * must call `invalidate()` to get a full redraw on the next frame.
+ */
+class TerminalRenderer {
+private:
+    std::vector<std::uint8_t> m_shown; ///< Tiles on the screen, as `Level::tiles()` was when presented.
+    StatusLine m_status;               ///< Status line on the screen.
+    size_t m_rows = 0;                 ///< Rows of the board on the screen.
+    size_t m_cols = 0;                 ///< Columns of the board on the screen.
+    bool m_valid = false;              ///< Whether the screen still shows the last frame.
+    FrameComposer m_frame;             ///< Bytes of the frame being built; reused across frames.
+
+    /**
+     * @brief Appends the sequence moving the cursor to a screen cell.
+     *
+     * @param row The 1-based screen row.
+     * @param col The 1-based screen column.
+     */
+    void move_to(size_t row, size_t col);
+
+public:
+    /**
+     * @brief Builds the frame showing a board, without writing it.
+     *
+     * The renderer assumes the frame is then written: the next one is a difference from it.
+     *
+     * @param board The board to draw, usually a `Level`.
+     * @param status The counters of the status line.
+     * @return The bytes of the frame.
+     */
+    std::string_view compose(const BoardView& board, const StatusLine& status);
+
+    /**
+     * @brief Builds and writes the frame showing a board.
+     *
+     * @param board The board to draw, usually a `Level`.
+     * @param status The counters of the status line.
+     */
+    void present(const BoardView& board, const StatusLine& status) {
+        compose(board, status);
+        m_frame.write_out();
+    }
+
+    /**
+     * @brief Forgets what is on the screen; the next frame is drawn in full.
+     */
+    void invalidate() { m_valid = false; }
+};
+
+#endif
@@ -0,0 +1,119 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+
+/// @brief Starts `n_threads - 1` workers; the thread calling `parallel_for` is the last one.
+WorkStealingPool::WorkStealingPool(size_t n_threads) {
+    size_t n_workers = std::max<size_t>(n_threads, 1) - 1;
+
+    for (size_t i = 0; i <= n_workers; ++i) m_queues.push_back(std::make_unique<Queue>());
+    for (size_t i = 0; i < n_workers; ++i) m_workers.emplace_back(&WorkStealingPool::worker_loop, this, i);
+}
+
+/// @brief Stops and joins the workers. No `parallel_for` may be running.
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_wake_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+
+    for (std::thread& worker : m_workers) worker.join();
+}
+
+/// @brief Queues a range at the back of `queue` and wakes a worker to steal it.
+void WorkStealingPool::push(size_t queue, const Task& task) {
+    // Counted before it can be taken, so that `take()` never brings the count below zero.
+    {
+        std::lock_guard<std::mutex> lock(m_wake_mutex);
+        ++m_pending;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_queues[queue]->mutex);
+        m_queues[queue]->tasks.push_back(task);
+    }
+    m_wake.notify_one();
+}
+
+/// @brief Pops the newest range of `queue`, or else steals the oldest range of another queue.
+bool WorkStealingPool::take(size_t queue, Task& task) {
+    {
+        Queue& own = *m_queues[queue];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (not own.tasks.empty()) {
+            task = own.tasks.back();
+            own.tasks.pop_back();
+            --m_pending;
+            return true;
+        }
+    }
+
+    for (size_t k = 1; k < m_queues.size(); ++k) {
+        Queue& victim = *m_queues[(queue + k) % m_queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (not victim.tasks.empty()) {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            --m_pending;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/// @brief Gives away halves of the range until it is down to the grain, then runs it.
+void WorkStealingPool::run(size_t queue, Task task) {
+    Batch& batch = *task.batch;
+
+    while (task.end - task.begin > batch.grain) {
+        size_t mid = task.begin + (task.end - task.begin) / 2;
+        push(queue, Task{task.batch, mid, task.end});
+        task.end = mid;
+    }
+
+    for (size_t i = task.begin; i < task.end; ++i) (*batch.body)(i);
+
+    size_t count = task.end - task.begin;
+    if (batch.remaining.fetch_sub(count) == count) {
+        // Notify while holding the lock: the caller cannot return, and destroy the batch, before.
+        std::lock_guard<std::mutex> lock(batch.mutex);
+        batch.finished = true;
+        batch.done.notify_all();
+    }
+}
+
+/// @brief Runs ranges, its own first, and sleeps while there are none anywhere.
+void WorkStealingPool::worker_loop(size_t queue) {
+    for (;;) {
+        Task task;
+        if (take(queue, task)) {
+            run(queue, task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_wake_mutex);
+        m_wake.wait(lock, [this]() { return m_stop or m_pending > 0; });
+        if (m_stop) return;
+    }
+}
+
+/// @brief Runs `body(i)` for every `i` in `[0, n)`, helping the workers until all are done.
+void WorkStealingPool::parallel_for(size_t n, const std::function<void(size_t)>& body, size_t grain) {
+    if (n == 0) return;
+
+    Batch batch;
+    batch.body = &body;
+    batch.grain = std::max<size_t>(grain, 1);
+    batch.remaining = n;
+
+    const size_t caller_queue = m_queues.size() - 1;
+    run(caller_queue, Task{&batch, 0, n});
+
+    // Help with whatever is queued (this loop's ranges or another caller's) until done.
+    Task task;
+    while (batch.remaining > 0 and take(caller_queue, task)) run(caller_queue, task);
+
+    std::unique_lock<std::mutex> lock(batch.mutex);
+    batch.done.wait(lock, [&batch]() { return batch.finished; });
+}
@@ -0,0 +1,91 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief A fixed set of worker threads that share loops by work stealing.
+ *
+ * Every worker owns a queue of index ranges. A worker splits the range it takes in
+ * halves, keeping one half to run and pushing the other back on its own queue, until
+ * the range is small enough. Idle workers steal the oldest (largest) range of another
+ * queue, so the work spreads out from whichever thread started it. The thread that
+ * calls `parallel_for` takes part too, through one extra queue.
+ *
+ * Several threads may call `parallel_for` at once; every call only waits for its own
+ * loop.
+ */
+class WorkStealingPool {
+private:
+    /// @brief One call to `parallel_for`, shared by the ranges it was split into.
+    struct Batch {
+        const std::function<void(size_t)>* body;  ///< The loop body
+        size_t grain;                             ///< Ranges at most this long are not split
+        std::atomic<size_t> remaining;            ///< Number of indices not run yet
+        std::mutex mutex;                         ///< Guards `finished`
+        std::condition_variable done;             ///< Signaled when `finished` is set
+        bool finished = false;                    ///< Every index has been run
+    };
+
+    /// @brief A range of indices of a batch.
+    struct Task {
+        Batch* batch;   ///< The loop the range belongs to
+        size_t begin;   ///< First index
+        size_t end;     ///< One past the last index
+    };
+
+    /// @brief The queue of a worker; the owner works at the back, thieves at the front.
+    struct Queue {
+        std::mutex mutex;          ///< Guards `tasks`
+        std::deque<Task> tasks;    ///< Ranges waiting to run
+    };
+
+    std::vector<std::unique_ptr<Queue>> m_queues;  ///< One per worker, plus one for the callers
+    std::vector<std::thread> m_workers;            ///< The worker threads
+    std::mutex m_wake_mutex;                       ///< Guards `m_stop` and the waits on `m_wake`
+    std::condition_variable m_wake;                ///< Signaled when ranges are queued or on shutdown
+    std::atomic<size_t> m_pending{0};              ///< Number of queued ranges
+    bool m_stop = false;                           ///< Set on destruction
+
+    void push(size_t queue, const Task& task);     ///< Queues a range and wakes a worker
+    bool take(size_t queue, Task& task);           ///< Pops from `queue`, or else steals from another one
+    void run(size_t queue, Task task);             ///< Splits a range down to the grain, then runs it
+    void worker_loop(size_t queue);                ///< Body of a worker thread
+
+public:
+    /**
+     * @brief Starts the workers.
+     *
+     * @param n_threads Number of threads that run a loop, counting the calling one:
+     *                  `n_threads - 1` workers are started. 0 counts as 1.
+     */
+    explicit WorkStealingPool(size_t n_threads);
+
+    /// @brief Stops and joins the workers.
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    /// @brief Gets the number of threads that run a loop, counting the calling one.
+    size_t size() const { return m_workers.size() + 1; }
+
+    /**
+     * @brief Runs `body(i)` for every `i` in `[0, n)` and waits for all of them.
+     *
+     * @param n Number of indices.
+     * @param body The loop body; calls for different indices may run concurrently.
+     * @param grain Ranges of at most this many indices are run by one thread in a row.
+     */
+    void parallel_for(size_t n, const std::function<void(size_t)>& body, size_t grain = 1);
+};
+
+#endif
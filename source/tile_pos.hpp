@@ -2,6 +2,15 @@
 #define TILE_POS_HPP
 
 #include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Compact index of a tile, as used by the engine (see `Level::index()`).
+ *
+ * Levels store their tiles in one flat array; a tile is its offset in it. The
+ * simulation keeps `TilePos` only to read level files and to draw the board.
+ */
+using cell_t = std::uint32_t;
 
 /**
  * @brief Represents a location inside the maze.
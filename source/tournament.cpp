@@ -0,0 +1,280 @@
+#include "SnazeSimulation.hpp"
+#include "level.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/// @brief One game of a tournament: a level file, a player type and a seed.
+struct TournamentRun {
+    std::size_t file = 0;          ///< Index of the level file in `level_files`.
+    player_type_e player = player_type_e::RANDOM; ///< Player type of the snake.
+    std::uint32_t seed = 0;        ///< Seed of the game.
+    RunSummary result;             ///< Outcome of the game.
+};
+
+/// @brief Percentiles reported for every measurement of a tournament pairing.
+static constexpr int PERCENTILES[] = {10, 50, 90};
+
+/**
+ * @brief Gets a percentile of some values, by the nearest-rank method.
+ *
+ * @param values The values, sorted in increasing order; not empty.
+ * @param percent The percentile, from 0 to 100.
+ * @return The smallest value at least `percent`% of the values are lower or equal to.
+ */
+static double percentile(const std::vector<double>& values, int percent) {
+    std::size_t rank = static_cast<std::size_t>(std::ceil(percent / 100.0 * values.size()));
+    return values[std::max<std::size_t>(rank, 1) - 1];
+}
+
+/**
+ * @brief Quotes a CSV field if it holds a separator, a quote or a line break.
+ *
+ * @param field The field.
+ * @return The field as it should be written.
+ */
+static std::string csv_field(std::string_view field) {
+    if (field.find_first_of(",\"\n") == std::string_view::npos) return std::string(field);
+
+    std::string quoted = "\"";
+    for (char ch : field) {
+        if (ch == '"') quoted += '"';
+        quoted += ch;
+    }
+    return quoted + '"';
+}
+
+/**
+ * @brief Writes a string as a JSON string literal.
+ *
+ * @param text The string.
+ * @return The literal, quotes included.
+ */
+static std::string json_string(std::string_view text) {
+    std::string literal = "\"";
+    for (char ch : text) {
+        if (ch == '"' or ch == '\\') {
+            literal += '\\';
+            literal += ch;
+        } else if (static_cast<unsigned char>(ch) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof escaped, "\\u%04x", ch);
+            literal += escaped;
+        } else {
+            literal += ch;
+        }
+    }
+    return literal + '"';
+}
+
+/**
+ * @brief Gets how a tournament game ended.
+ *
+ * @param run The game.
+ * @return "won", "lost", or "capped" if it was stopped at the step limit.
+ */
+static std::string_view outcome(const TournamentRun& run) {
+    if (run.result.capped) return "capped";
+    return run.result.won ? "won" : "lost";
+}
+
+/**
+ * @brief Plays every level file against every tournament player type and seed.
+ *
+ * A map is prepared per input file: a copy of this simulation holding only that
+ * file's levels, with the snake on its first level and, if the HAMILTONIAN player
+ * takes part, its cycles searched once. Every run copies its map, sets its player
+ * type and seed, and is played headless until the game is over or `max_steps` moves
+ * were made, by workers picking the next unplayed run from a shared counter.
+ *
+ * Output, on standard output:
+ * - CSV (default): one row per run, then an empty line and one row per file and
+ *   player type with the 10th, 50th and 90th percentiles of every measurement;
+ * - JSON (`--format json`): an object with the `runs` and `aggregates` arrays.
+ *
+ * Seeds go from `--seed` (1 if not given) to `--seed + --seeds - 1`, so that two
+ * tournaments with the same options play the same games.
+ *
+ * @return EXIT_SUCCESS once every run has been played.
+ */
+int SnazeSimulation::run_tournament() const {
+    bool with_hamiltonian = std::find(tournament_players.begin(), tournament_players.end(), player_type_e::HAMILTONIAN) != tournament_players.end();
+    std::uint32_t first_seed = seeded ? seed : 1;
+
+    std::vector<SnazeSimulation> maps;
+    for (const LevelFile& file : level_files) {
+        SnazeSimulation map = *this;
+        map.levels.assign(levels.begin() + file.first, levels.begin() + file.first + file.count);
+        map.level_files.clear();
+        map.level_stats.assign(file.count, ThinkStats{});
+        map.current_level_index = 0;
+
+        if (not map.levels.empty()) {
+            map.head_pos = map.levels[0].get_spawn_loc();
+            map.dir = direction::right;
+            map.levels[0].set_tile_type(Level::tile_type_e::SNAKE_HEAD, map.head_pos);
+            map.snake_obj.init(map.levels[0], map.head_pos);
+        }
+        if (with_hamiltonian) map.precompute_cycles(false);
+
+        maps.push_back(std::move(map));
+    }
+
+    // Files are the outer loop, so that rows of the same map come together.
+    std::vector<TournamentRun> runs;
+    for (std::size_t file = 0; file < maps.size(); ++file) {
+        if (maps[file].levels.empty()) continue;
+        for (player_type_e player : tournament_players) {
+            for (int i = 0; i < n_seeds; ++i) {
+                TournamentRun run;
+                run.file = file;
+                run.player = player;
+                run.seed = first_seed + static_cast<std::uint32_t>(i);
+                runs.push_back(run);
+            }
+        }
+    }
+
+    std::atomic<std::size_t> next_run{0};
+
+    auto worker = [&]() {
+        for (std::size_t id = next_run++; id < runs.size(); id = next_run++) {
+            TournamentRun& run = runs[id];
+            SnazeSimulation game = maps[run.file];
+            game.player_type = run.player;
+            game.reseed(run.seed);
+            game.start_time = std::chrono::steady_clock::now();
+
+            while (not game.is_over() and not game.step_limit_reached()) {
+                game.process_events();
+                game.update();
+                game.render();
+            }
+
+            run.result = game.summary();
+        }
+    };
+
+    auto tournament_start = std::chrono::steady_clock::now();
+
+    std::size_t n_workers = std::max<std::size_t>(1, std::min<std::size_t>(runs.size(), std::thread::hardware_concurrency()));
+    std::vector<std::thread> pool;
+    for (std::size_t i = 0; i < n_workers; ++i) pool.emplace_back(worker);
+    for (auto& t : pool) t.join();
+
+    std::chrono::duration<double, std::milli> tournament_time = std::chrono::steady_clock::now() - tournament_start;
+
+    // Measurements aggregated per pairing, in the order of the run table.
+    struct Measure {
+        const char* name;
+        double (*get)(const RunSummary&);
+    };
+    static constexpr Measure measures[] = {
+        {"score", [](const RunSummary& r) { return static_cast<double>(r.score); }},
+        {"food", [](const RunSummary& r) { return static_cast<double>(r.food); }},
+        {"deaths", [](const RunSummary& r) { return static_cast<double>(r.deaths); }},
+        {"steps", [](const RunSummary& r) { return static_cast<double>(r.steps); }},
+        {"think_ms", [](const RunSummary& r) { return r.thinking.think_ms; }},
+        {"wall_ms", [](const RunSummary& r) { return r.wall_ms; }},
+    };
+
+    // Run table
+    if (json_output) {
+        std::cout << "{\"threads\": " << n_workers
+                  << ", \"wall_ms\": " << tournament_time.count()
+                  << ", \"max_steps\": " << max_steps
+                  << ",\n\"runs\": [\n";
+    } else {
+        std::cout << "file,player,seed,result,score,food,deaths,steps,levels_cleared,think_ms,wall_ms\n";
+    }
+
+    for (std::size_t id = 0; id < runs.size(); ++id) {
+        const TournamentRun& run = runs[id];
+        const std::string& path = level_files[run.file].path;
+
+        if (json_output) {
+            std::cout << "  {\"file\": " << json_string(path)
+                      << ", \"player\": " << json_string(player_name(run.player))
+                      << ", \"seed\": " << run.seed
+                      << ", \"result\": " << json_string(outcome(run))
+                      << ", \"levels_cleared\": " << run.result.levels_cleared;
+            for (const Measure& m : measures) std::cout << ", \"" << m.name << "\": " << m.get(run.result);
+            std::cout << '}' << (id + 1 < runs.size() ? "," : "") << '\n';
+        } else {
+            std::cout << csv_field(path) << ',' << player_name(run.player) << ',' << run.seed << ',' << outcome(run)
+                      << ',' << run.result.score << ',' << run.result.food << ',' << run.result.deaths
+                      << ',' << run.result.steps << ',' << run.result.levels_cleared
+                      << ',' << run.result.thinking.think_ms << ',' << run.result.wall_ms << '\n';
+        }
+    }
+
+    // Aggregates: the runs of a pairing are contiguous, `n_seeds` of them.
+    if (json_output) {
+        std::cout << "],\n\"aggregates\": [\n";
+    } else {
+        std::cout << "\nfile,player,runs,won,capped";
+        for (const Measure& m : measures) {
+            for (int p : PERCENTILES) std::cout << ',' << m.name << "_p" << p;
+        }
+        std::cout << '\n';
+    }
+
+    for (std::size_t begin = 0; begin < runs.size(); begin += n_seeds) {
+        std::size_t end = std::min(runs.size(), begin + n_seeds);
+        const TournamentRun& first = runs[begin];
+
+        int won = 0;
+        int capped = 0;
+        for (std::size_t id = begin; id < end; ++id) {
+            won += runs[id].result.won;
+            capped += runs[id].result.capped;
+        }
+
+        if (json_output) {
+            std::cout << "  {\"file\": " << json_string(level_files[first.file].path)
+                      << ", \"player\": " << json_string(player_name(first.player))
+                      << ", \"runs\": " << end - begin
+                      << ", \"won\": " << won
+                      << ", \"capped\": " << capped;
+        } else {
+            std::cout << csv_field(level_files[first.file].path) << ',' << player_name(first.player)
+                      << ',' << end - begin << ',' << won << ',' << capped;
+        }
+
+        for (const Measure& m : measures) {
+            std::vector<double> values;
+            for (std::size_t id = begin; id < end; ++id) values.push_back(m.get(runs[id].result));
+            std::sort(values.begin(), values.end());
+
+            if (json_output) {
+                std::cout << ", \"" << m.name << "\": {";
+                for (int p : PERCENTILES) {
+                    std::cout << (p == PERCENTILES[0] ? "" : ", ") << "\"p" << p << "\": " << percentile(values, p);
+                }
+                std::cout << '}';
+            } else {
+                for (int p : PERCENTILES) std::cout << ',' << percentile(values, p);
+            }
+        }
+
+        if (json_output) {
+            std::cout << '}' << (end < runs.size() ? "," : "") << '\n';
+        } else {
+            std::cout << '\n';
+        }
+    }
+
+    if (json_output) std::cout << "]}\n";
+
+    return EXIT_SUCCESS;
+}
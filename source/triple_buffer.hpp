@@ -0,0 +1,63 @@
+#ifndef TRIPLE_BUFFER_HPP
+#define TRIPLE_BUFFER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Lock-free hand-over of the latest value from one writer thread to one reader thread.
+ *
+ * Three slots rotate between the writer (the back slot it fills), the reader (the front
+ * slot it reads) and a middle slot that holds the latest published value. Publishing
+ * swaps the back and middle slots, and taking swaps the middle and front slots; both are
+ * a single atomic exchange, so neither thread ever waits for the other. A value published
+ * before the reader took the previous one replaces it: the older value is dropped.
+ *
+ * The slots are reused, so a `T` holding buffers (e.g. a `std::vector`) stops allocating
+ * once the three slots have grown to size.
+ *
+ * @tparam T The type of the values.
+ */
+template <typename T>
+class TripleBuffer {
+private:
+    static constexpr std::uint8_t INDEX = 3;  ///< Bits of `m_middle` holding the slot index.
+    static constexpr std::uint8_t FRESH = 4;  ///< Bit of `m_middle` set while it holds a value not taken yet.
+
+    std::array<T, 3> m_slots;                 ///< The values.
+    std::uint8_t m_back = 0;                  ///< Slot the writer fills; only touched by the writer.
+    std::atomic<std::uint8_t> m_middle{1};    ///< Latest published slot, plus the `FRESH` bit.
+    std::uint8_t m_front = 2;                 ///< Slot the reader reads; only touched by the reader.
+
+public:
+    /// @brief Gets the slot to fill before `publish()`. Writer only.
+    T& back() { return m_slots[m_back]; }
+
+    /**
+     * @brief Makes the back slot the latest value. Writer only.
+     *
+     * @return True if the previous value was never taken, and is now dropped.
+     */
+    bool publish() {
+        std::uint8_t previous = m_middle.exchange(m_back | FRESH, std::memory_order_acq_rel);
+        m_back = previous & INDEX;
+        return previous & FRESH;
+    }
+
+    /**
+     * @brief Takes the latest value, if there is a new one. Reader only.
+     *
+     * @return True if `front()` now holds a value not seen before.
+     */
+    bool take() {
+        if (not (m_middle.load(std::memory_order_relaxed) & FRESH)) return false;
+        m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & INDEX;
+        return true;
+    }
+
+    /// @brief Gets the value taken last. Reader only.
+    const T& front() const { return m_slots[m_front]; }
+};
+
+#endif